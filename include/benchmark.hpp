@@ -0,0 +1,101 @@
+#pragma once
+
+#ifdef EVB_BLAS
+#include "cblas.h"
+#endif
+
+#include <eigen3/Eigen/Dense>
+#include "etl/etl.hpp"
+#include <blaze/Math.h>
+
+// The operands are filled by the harness (EVB_DATA), identically for all the libraries
+#define CPM_NO_RANDOM_INITIALIZATION
+#define CPM_NO_RANDOMIZATION
+#define CPM_AUTO_STEPS
+#define CPM_STEP_ESTIMATION_MIN 0.025   //Run during 0.025 seconds for estimating steps
+#define CPM_RUNTIME_TARGET 0.9          //Run each test during 0.9 seconds
+
+#include "cpm/cpm.hpp"
+
+#include "evb/harness.hpp"
+
+template<typename T>
+using etl_dyn_vector = etl::dyn_vector<T>;
+
+template<typename T>
+using blaze_dyn_vector = blaze::DynamicVector<T>;
+
+template<typename T>
+using blaze_dyn_vector_row = blaze::DynamicVector<T,blaze::rowVector>;
+
+template<typename T>
+using etl_dyn_matrix = etl::dyn_matrix<T>;
+
+template<typename T>
+using blaze_dyn_matrix = blaze::DynamicMatrix<T>;
+
+template<typename T>
+using eigen_dyn_vector = Eigen::Matrix<T, Eigen::Dynamic, 1>;
+
+template<typename T>
+using eigen_dyn_vector_row = Eigen::Matrix<T, 1, Eigen::Dynamic>;
+
+template<typename T>
+using eigen_dyn_matrix = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>;
+
+// The default storage order is row-major for ETL and Blaze and column-major
+// for Eigen, these are the matrices in the other storage order
+
+template<typename T>
+using etl_dyn_matrix_cm = etl::dyn_matrix_cm<T>;
+
+template<typename T>
+using blaze_dyn_matrix_cm = blaze::DynamicMatrix<T, blaze::columnMajor>;
+
+template<typename T>
+using eigen_dyn_matrix_rm = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+using etl_dvec = etl_dyn_vector<double>;
+using blaze_dvec = blaze_dyn_vector<double>;
+using blaze_dvec_row = blaze_dyn_vector_row<double>;
+using eigen_dvec = eigen_dyn_vector<double>;
+
+using etl_dmat = etl_dyn_matrix<double>;
+using blaze_dmat = blaze_dyn_matrix<double>;
+using eigen_dmat = eigen_dyn_matrix<double>;
+
+using etl_dmat_cm = etl_dyn_matrix_cm<double>;
+using blaze_dmat_cm = blaze_dyn_matrix_cm<double>;
+using eigen_dmat_rm = eigen_dyn_matrix_rm<double>;
+
+using etl_svec = etl_dyn_vector<float>;
+using blaze_svec = blaze_dyn_vector<float>;
+using eigen_svec = eigen_dyn_vector<float>;
+
+using etl_smat = etl_dyn_matrix<float>;
+using blaze_smat = blaze_dyn_matrix<float>;
+using eigen_smat = eigen_dyn_matrix<float>;
+
+using etl_smat_cm = etl_dyn_matrix_cm<float>;
+using blaze_smat_cm = blaze_dyn_matrix_cm<float>;
+using eigen_smat_rm = eigen_dyn_matrix_rm<float>;
+
+// Types with sizes known at compile-time
+
+template<typename T, std::size_t N>
+using etl_fast_vector = etl::fast_vector<T, N>;
+
+template<typename T, std::size_t N>
+using blaze_static_vector = blaze::StaticVector<T, N>;
+
+template<typename T, std::size_t N>
+using eigen_fixed_vector = Eigen::Matrix<T, N, 1>;
+
+template<typename T, std::size_t N, std::size_t M>
+using etl_fast_matrix = etl::fast_matrix<T, N, M>;
+
+template<typename T, std::size_t N, std::size_t M>
+using blaze_static_matrix = blaze::StaticMatrix<T, N, M>;
+
+template<typename T, std::size_t N, std::size_t M>
+using eigen_fixed_matrix = Eigen::Matrix<T, N, M>;
@@ -0,0 +1,40 @@
+#pragma once
+
+// Heap allocation tracking around the measured lambdas (EVB_ALLOC).
+//
+// The allocation functions of the C library are interposed in src/alloc.cpp,
+// which also covers operator new, the aligned allocators of the libraries and
+// the allocations of the BLAS backend. The counters are only active between
+// alloc_start() and alloc_stop(), the other allocations only cost a check.
+// The peak is the high-water mark of the heap bytes counted by the allocator
+// (malloc_usable_size), not of the resident memory.
+
+#include <cstddef>
+
+namespace evb {
+
+/*!
+ * \brief The allocations done during one tracking window
+ */
+struct alloc_stats {
+    std::size_t allocs = 0; ///< Number of allocations
+    std::size_t bytes  = 0; ///< Number of bytes allocated
+    std::size_t peak   = 0; ///< Heap high-water mark, above the live heap bytes at the start of the window
+};
+
+/*!
+ * \brief Indicates if the allocations can be tracked (glibc only)
+ */
+bool alloc_available();
+
+/*!
+ * \brief Start counting the allocations of all threads
+ */
+void alloc_start();
+
+/*!
+ * \brief Stop counting the allocations and return what was counted since alloc_start()
+ */
+alloc_stats alloc_stop();
+
+} //end of namespace evb
@@ -0,0 +1,262 @@
+#pragma once
+
+// Detection of the data caches of the machine and cache-regime working sets.
+// A regime is a working set size expressed as a fraction of a cache level (or
+// a multiple of the last level, for DRAM), so that the same benchmark lands in
+// the same level of the hierarchy on every machine.
+//
+// In cold mode (EVB_COLD=1), the operands are flushed from all the caches
+// before each measured call.
+
+#include <cstddef>
+#include <cstdio>
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "evb/memory.hpp"
+
+namespace evb {
+
+/*!
+ * \brief A level of data (or unified) cache
+ */
+struct cache_level {
+    std::size_t level; ///< The level, starting at 1
+    std::size_t bytes; ///< The size of one cache of this level
+};
+
+/*!
+ * \brief The cache hierarchy of the machine
+ */
+struct cache_info {
+    std::vector<cache_level> levels; ///< Sorted by level
+    std::size_t line = 64;           ///< The size of a cache line
+};
+
+namespace detail {
+
+inline std::string read_sysfs(const std::string& path){
+    std::ifstream stream(path);
+    std::string value;
+    stream >> value;
+    return value;
+}
+
+// Parse sizes like "48K" or "32M"
+inline std::size_t parse_cache_size(const std::string& value){
+    std::size_t bytes = 0;
+    std::size_t i     = 0;
+
+    for(; i < value.size() && value[i] >= '0' && value[i] <= '9'; ++i){
+        bytes = bytes * 10 + (value[i] - '0');
+    }
+
+    if(i < value.size()){
+        switch(value[i]){
+            case 'K':
+                return bytes << 10;
+            case 'M':
+                return bytes << 20;
+            case 'G':
+                return bytes << 30;
+        }
+    }
+
+    return bytes;
+}
+
+inline cache_info detect_caches(){
+    cache_info info;
+
+    const std::string base = "/sys/devices/system/cpu/cpu0/cache/index";
+
+    for(std::size_t index = 0;; ++index){
+        auto level = read_sysfs(base + std::to_string(index) + "/level");
+
+        if(level.empty()){
+            break;
+        }
+
+        auto type = read_sysfs(base + std::to_string(index) + "/type");
+
+        if(type != "Data" && type != "Unified"){
+            continue;
+        }
+
+        auto bytes = parse_cache_size(read_sysfs(base + std::to_string(index) + "/size"));
+        auto line  = parse_cache_size(read_sysfs(base + std::to_string(index) + "/coherency_line_size"));
+
+        if(bytes){
+            info.levels.push_back({std::stoul(level), bytes});
+        }
+
+        if(line){
+            info.line = line;
+        }
+    }
+
+    if(info.levels.empty()){
+        std::fprintf(stderr, "[evb] cache sizes not available, assuming 32KiB/1MiB/32MiB\n");
+
+        info.levels = {{1, std::size_t(32) << 10}, {2, std::size_t(1) << 20}, {3, std::size_t(32) << 20}};
+    }
+
+    std::sort(info.levels.begin(), info.levels.end(), [](const cache_level& a, const cache_level& b){ return a.level < b.level; });
+
+    return info;
+}
+
+} //end of namespace detail
+
+/*!
+ * \brief Return the cache hierarchy of the machine, detected on first use
+ */
+inline const cache_info& get_caches(){
+    static cache_info info = detail::detect_caches();
+    return info;
+}
+
+/*!
+ * \brief Return the size of the given cache level, or of the closest smaller level if it does not exist
+ */
+inline std::size_t cache_size(std::size_t level){
+    auto& levels = get_caches().levels;
+
+    std::size_t bytes = levels.front().bytes;
+
+    for(auto& l : levels){
+        if(l.level <= level){
+            bytes = l.bytes;
+        }
+    }
+
+    return bytes;
+}
+
+/*!
+ * \brief Return the name of the smallest cache level that can hold the given working set
+ */
+inline std::string cache_level_name(std::size_t bytes){
+    for(auto& l : get_caches().levels){
+        if(bytes <= l.bytes){
+            return "L" + std::to_string(l.level);
+        }
+    }
+
+    return "DRAM";
+}
+
+/*!
+ * \brief Number of cache regimes, see regime_bytes
+ */
+constexpr std::size_t regimes = 12;
+
+namespace detail {
+
+struct regime {
+    std::size_t level; ///< The cache level, 0 for DRAM
+    double factor;     ///< The factor to apply to the cache level (the last level for DRAM)
+};
+
+inline const regime& get_regime(std::size_t r){
+    static const regime table[regimes] = {
+        {1, 0.25}, {1, 0.5}, {1, 0.75},
+        {2, 0.25}, {2, 0.5}, {2, 0.75},
+        {3, 0.25}, {3, 0.5}, {3, 0.75},
+        {0, 2.0}, {0, 4.0}, {0, 8.0}};
+
+    return table[std::min(r, regimes - 1)];
+}
+
+} //end of namespace detail
+
+/*!
+ * \brief Return the working set size of the given regime, in bytes.
+ *
+ * The regimes 0 to 8 are a quarter, half and three quarters of L1, L2 and
+ * L3, the regimes 9 to 11 are 2, 4 and 8 times the last level of cache.
+ */
+inline std::size_t regime_bytes(std::size_t r){
+    auto& regime = detail::get_regime(r);
+    auto level   = regime.level ? regime.level : get_caches().levels.back().level;
+
+    return static_cast<std::size_t>(regime.factor * cache_size(level));
+}
+
+/*!
+ * \brief Return a readable description of the given regime
+ */
+inline std::string regime_name(std::size_t r){
+    auto& regime = detail::get_regime(r);
+
+    char buffer[32];
+
+    if(regime.level){
+        std::snprintf(buffer, sizeof(buffer), "%.2fxL%zu", regime.factor, regime.level);
+    } else {
+        std::snprintf(buffer, sizeof(buffer), "%.0fxLLC", regime.factor);
+    }
+
+    return buffer;
+}
+
+/*!
+ * \brief Flush the given memory from all the levels of cache
+ */
+inline void flush(const memory_range& range){
+#if defined(__SSE2__)
+    const std::size_t line = get_caches().line;
+
+    for(const char* p = range.begin; p < range.end; p += line){
+        _mm_clflush(p);
+    }
+
+    _mm_clflush(range.end - 1);
+    _mm_mfence();
+#else
+    (void)range;
+#endif
+}
+
+/*!
+ * \brief Evict the caches of the current core by writing to a buffer larger than the last level
+ */
+inline void evict_all(){
+    static std::vector<char> buffer(2 * get_caches().levels.back().bytes);
+
+    const std::size_t line = get_caches().line;
+
+    for(std::size_t i = 0; i < buffer.size(); i += line){
+        ++buffer[i];
+    }
+
+    volatile char sink = buffer[0];
+    (void)sink;
+}
+
+/*!
+ * \brief Evict the given operands from the caches.
+ *
+ * When the memory of all the operands is known, each of them is flushed with
+ * clflush, from the caches of all the cores. Otherwise, the caches of the
+ * current core are evicted with a scratch buffer.
+ */
+template <typename... T>
+void evict(const T&... values){
+#if defined(__SSE2__)
+    if(all_memory_known(values...)){
+        for_each_memory([](const memory_range& range){ flush(range); }, values...);
+        return;
+    }
+#endif
+
+    evict_all();
+}
+
+} //end of namespace evb
@@ -0,0 +1,180 @@
+#pragma once
+
+// Runtime configuration of the harness. Every mode is selected from the
+// environment since the command line belongs to CPM.
+
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <thread>
+#include <sstream>
+
+#include "evb/data.hpp"
+
+namespace evb {
+
+/*!
+ * \brief Return the value of the given environment variable or the default value if unset
+ */
+inline std::string env_string(const char* name, const std::string& def = ""){
+    const char* value = std::getenv(name);
+    return value ? std::string(value) : def;
+}
+
+/*!
+ * \brief Indicates if the given environment variable is set to a true value, or the default value if unset
+ */
+inline bool env_flag(const char* name, bool def = false){
+    auto value = env_string(name);
+
+    if(value.empty()){
+        return def;
+    }
+
+    return value != "0" && value != "false" && value != "off";
+}
+
+/*!
+ * \brief Return the number in the given environment variable or the default value if unset or invalid
+ */
+template <typename T>
+T env_number(const char* name, T def){
+    auto value = env_string(name);
+
+    if(value.empty()){
+        return def;
+    }
+
+    std::istringstream stream(value);
+    T number;
+
+    if(!(stream >> number) || !stream.eof()){
+        std::fprintf(stderr, "[evb] invalid %s value \"%s\", using the default\n", name, value.c_str());
+        return def;
+    }
+
+    return number;
+}
+
+/*!
+ * \brief Split a comma-separated list
+ */
+inline std::vector<std::string> split(const std::string& value, char sep = ','){
+    std::vector<std::string> parts;
+    std::stringstream stream(value);
+    std::string part;
+
+    while(std::getline(stream, part, sep)){
+        if(!part.empty()){
+            parts.push_back(part);
+        }
+    }
+
+    return parts;
+}
+
+/*!
+ * \brief Return the thread counts to sweep for the given EVB_THREADS value.
+ *
+ * "sweep" selects 1, 2, 4, ... up to the number of hardware threads (which
+ * is always included), otherwise a list such as "1,2,8" is expected.
+ */
+inline std::vector<std::size_t> parse_threads(const std::string& value){
+    std::vector<std::size_t> threads;
+
+    if(value == "sweep"){
+        std::size_t max = std::max(1U, std::thread::hardware_concurrency());
+
+        for(std::size_t t = 1; t < max; t *= 2){
+            threads.push_back(t);
+        }
+
+        threads.push_back(max);
+    } else {
+        for(auto& part : split(value)){
+            threads.push_back(std::max(1UL, std::stoul(part)));
+        }
+    }
+
+    return threads;
+}
+
+/*!
+ * \brief Parse a list of CPUs or NUMA nodes such as "0-3,8,10-11", empty if invalid
+ */
+inline std::vector<std::size_t> parse_list(const std::string& value){
+    std::vector<std::size_t> list;
+
+    for(auto& part : split(value)){
+        auto dash = part.find('-');
+
+        std::size_t first = 0;
+        std::size_t last  = 0;
+
+        if(part.find_first_not_of("0123456789-") != std::string::npos || !(std::istringstream(part.substr(0, dash)) >> first)
+                || (dash != std::string::npos && !(std::istringstream(part.substr(dash + 1)) >> last))){
+            std::fprintf(stderr, "[evb] invalid list \"%s\", ignored\n", value.c_str());
+            return {};
+        }
+
+        if(dash == std::string::npos){
+            last = first;
+        }
+
+        for(std::size_t i = first; i <= last; ++i){
+            list.push_back(i);
+        }
+    }
+
+    return list;
+}
+
+/*!
+ * \brief The configuration of the harness, read once from the environment
+ */
+struct config {
+    std::vector<std::size_t> threads; ///< The thread counts to sweep (EVB_THREADS), empty for single-threaded runs
+    bool perf;                        ///< Collect hardware counters (EVB_PERF)
+    bool roofline;                    ///< Probe the machine and report results relative to its roofline (EVB_ROOFLINE)
+    bool cold;                        ///< Evict the operands from the caches before each measured call (EVB_COLD)
+    bool alloc;                       ///< Count the heap allocations of the measured calls (EVB_ALLOC)
+    std::string csv;                  ///< Append the results to this CSV file (EVB_CSV)
+    std::vector<std::size_t> cpus;    ///< The CPUs the threads are pinned to (EVB_CPUS), empty for no pinning
+    std::string numa;                 ///< The placement of the operands: local, remote, interleave or a node (EVB_NUMA)
+    distribution data;                ///< The distribution of the input data (EVB_DATA)
+    std::size_t seed;                 ///< The seed of the input data (EVB_SEED)
+    bool validate;                    ///< Compare the results of the libraries (EVB_VALIDATE)
+    double tolerance;                 ///< The relative tolerance of the validation, 0 for the default (EVB_TOLERANCE)
+    bool report;                      ///< Print the harness report after each section (EVB_REPORT)
+
+    config(){
+        threads  = parse_threads(env_string("EVB_THREADS"));
+        perf     = env_flag("EVB_PERF");
+        roofline = env_flag("EVB_ROOFLINE");
+        cold     = env_flag("EVB_COLD");
+        alloc    = env_flag("EVB_ALLOC");
+        csv      = env_string("EVB_CSV");
+        cpus     = parse_list(env_string("EVB_CPUS"));
+        numa     = env_string("EVB_NUMA");
+
+        data      = parse_distribution(env_string("EVB_DATA"));
+        seed      = env_number<std::size_t>("EVB_SEED", 42);
+        validate  = env_flag("EVB_VALIDATE", true);
+        tolerance = env_number<double>("EVB_TOLERANCE", 0.0);
+
+        // The times of CPM include the eviction, only the report is accurate in cold mode
+        report = env_flag("EVB_REPORT") || !threads.empty() || perf || roofline || cold || alloc || !cpus.empty() || !numa.empty();
+    }
+};
+
+/*!
+ * \brief Return the configuration of the harness
+ */
+inline const config& get_config(){
+    static config conf;
+    return conf;
+}
+
+} //end of namespace evb
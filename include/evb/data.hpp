@@ -0,0 +1,239 @@
+#pragma once
+
+// Deterministic input data. The containers are filled by index with a seeded
+// generator, so that every library gets exactly the same values.
+//
+// The values of dense vectors and matrices of every library are visited in
+// the same logical order (row-major for matrices, whatever their storage
+// order), which is used by the harness to fill the operands of each point
+// (EVB_DATA) and to compare the results of the libraries (EVB_VALIDATE).
+
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "evb/memory.hpp"
+
+namespace evb {
+
+/*!
+ * \brief The distributions of the generated input data
+ */
+enum class distribution {
+    zero,     ///< Leave the operands as initialized by the sections, mostly zeros
+    uniform,  ///< Uniform in [-1, 1)
+    normal,   ///< Standard normal
+    denormal, ///< Small multiples of the smallest normal value, with random signs
+    range     ///< Random signs and magnitudes over a quarter of the decimal exponents
+};
+
+/*!
+ * \brief Parse the name of a distribution, for EVB_DATA
+ */
+inline distribution parse_distribution(const std::string& value){
+    if(value == "zero"){
+        return distribution::zero;
+    } else if(value == "normal"){
+        return distribution::normal;
+    } else if(value == "denormal"){
+        return distribution::denormal;
+    } else if(value == "range"){
+        return distribution::range;
+    } else if(!value.empty() && value != "uniform"){
+        std::fprintf(stderr, "[evb] unknown data distribution %s, using uniform\n", value.c_str());
+    }
+
+    return distribution::uniform;
+}
+
+/*!
+ * \brief A seeded generator of values of a distribution
+ */
+struct value_generator {
+    value_generator(distribution dist, std::size_t seed) : dist(dist), engine(seed) {}
+
+    template <typename T>
+    T next(){
+        switch(dist){
+            case distribution::normal:
+                return static_cast<T>(std::normal_distribution<double>(0.0, 1.0)(engine));
+
+            case distribution::denormal:
+                // Sums and differences of such values are often denormals
+                return sign() * std::uniform_real_distribution<T>(T(0.5), T(4))(engine) * std::numeric_limits<T>::min();
+
+            case distribution::range: {
+                const T exponent = std::numeric_limits<T>::max_exponent10 / 4;
+                return sign() * std::pow(T(10), std::uniform_real_distribution<T>(-exponent, exponent)(engine));
+            }
+
+            default:
+                return static_cast<T>(std::uniform_real_distribution<double>(-1.0, 1.0)(engine));
+        }
+    }
+
+private:
+    int sign(){
+        return engine() & 1 ? 1 : -1;
+    }
+
+    distribution dist;
+    std::mt19937_64 engine;
+};
+
+namespace detail {
+
+// A reference to a floating-point value of a dense container
+template <typename R>
+using value_reference = std::enable_if_t<std::is_lvalue_reference<R>::value && std::is_floating_point<std::decay_t<R>>::value, std::size_t>;
+
+// Operands that visit their own values, when their containers are only known
+// by the functor that built them
+template <typename V, typename F>
+auto for_each_value(V& v, F&& f, priority<5> /*p*/) -> decltype(v.for_each_value(f), std::size_t()){
+    return v.for_each_value(f);
+}
+
+// Batches of containers, in order
+template <typename M, typename A, typename F, typename = std::enable_if_t<!std::is_arithmetic<M>::value>>
+std::size_t for_each_value(std::vector<M, A>& v, F&& f, priority<4> /*p*/){
+    std::size_t n = 0;
+
+    for(auto& m : v){
+        n += for_each_value(m, f, priority<5>());
+    }
+
+    return n;
+}
+
+// Matrices with rows() and cols() (Eigen dense matrices and vectors)
+template <typename M, typename F>
+auto for_each_value(M& m, F&& f, priority<4> /*p*/) -> decltype(m.rows(), m.cols(), value_reference<decltype(m(0, 0))>()){
+    for(std::size_t i = 0; i < std::size_t(m.rows()); ++i){
+        for(std::size_t j = 0; j < std::size_t(m.cols()); ++j){
+            f(m(i, j));
+        }
+    }
+
+    return std::size_t(m.rows() * m.cols());
+}
+
+// Matrices with rows(m) and columns(m) (ETL and Blaze dense matrices)
+template <typename M, typename F>
+auto for_each_value(M& m, F&& f, priority<3> /*p*/) -> decltype(rows(m), columns(m), value_reference<decltype(m(0, 0))>()){
+    for(std::size_t i = 0; i < std::size_t(rows(m)); ++i){
+        for(std::size_t j = 0; j < std::size_t(columns(m)); ++j){
+            f(m(i, j));
+        }
+    }
+
+    return std::size_t(rows(m) * columns(m));
+}
+
+// Containers with contiguous memory (vectors, ETL containers of higher
+// dimensions, Eigen tensors), in memory order. This must come before
+// operator[], which only exists for rank 1 Eigen tensors.
+template <typename V, typename F>
+auto for_each_value(V& v, F&& f, priority<2> /*p*/) -> decltype(v.size(), value_reference<decltype(*v.data())>()){
+    const std::size_t n = v.size();
+
+    for(std::size_t i = 0; i < n; ++i){
+        f(v.data()[i]);
+    }
+
+    return n;
+}
+
+// Other vectors, with size() and operator[]
+template <typename V, typename F>
+auto for_each_value(V& v, F&& f, priority<1> /*p*/) -> decltype(v.size(), value_reference<decltype(v[0])>()){
+    const std::size_t n = v.size();
+
+    for(std::size_t i = 0; i < n; ++i){
+        f(v[i]);
+    }
+
+    return n;
+}
+
+template <typename V, typename F>
+std::size_t for_each_value(V& /*v*/, F&& /*f*/, priority<0> /*p*/){
+    return 0;
+}
+
+} //end of namespace detail
+
+/*!
+ * \brief Call the functor on a reference to each value of the given
+ * operand, in logical order, and return the number of values.
+ *
+ * Sparse containers and unknown types have no values.
+ */
+template <typename T, typename F>
+std::size_t for_each_value(T& value, F&& f){
+    return detail::for_each_value(value, f, detail::priority<5>());
+}
+
+namespace detail {
+
+template <typename T>
+auto operands_of(T& value, priority<1> /*p*/) -> decltype(value.operands()){
+    return value.operands();
+}
+
+template <typename T>
+std::tuple<T&> operands_of(T& value, priority<0> /*p*/){
+    return std::tuple<T&>(value);
+}
+
+} //end of namespace detail
+
+/*!
+ * \brief Return a tuple of references to the containers of the given
+ * operand. Operands holding several containers (batches of raw buffers, for
+ * instance) list them with operands(), other operands are their own only
+ * container.
+ */
+template <typename T>
+auto operands_of(T& value){
+    return detail::operands_of(value, detail::priority<1>());
+}
+
+/*!
+ * \brief Fill the given operand with values of the distribution
+ */
+template <typename T>
+void fill(T& value, distribution dist, std::size_t seed){
+    if(dist == distribution::zero){
+        return;
+    }
+
+    value_generator generator(dist, seed);
+
+    for_each_value(value, [&generator](auto& v){ v = generator.template next<std::decay_t<decltype(v)>>(); });
+}
+
+/*!
+ * \brief Fill the given vector with values uniformly distributed in [low, high)
+ */
+template <typename V>
+void fill_uniform(V& v, double low, double high, std::size_t seed = 42){
+    using value_type = typename std::decay<decltype(v[0])>::type;
+
+    std::mt19937_64 generator(seed);
+    std::uniform_real_distribution<double> dist(low, high);
+
+    const std::size_t n = v.size();
+
+    for(std::size_t i = 0; i < n; ++i){
+        v[i] = static_cast<value_type>(dist(generator));
+    }
+}
+
+} //end of namespace evb
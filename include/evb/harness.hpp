@@ -0,0 +1,1038 @@
+#pragma once
+
+// Thin layer on top of CPM. Each measured lambda is wrapped so that the
+// harness knows which section, library and size point is running. This is
+// used to run every library at several thread counts and to print a report
+// with derived metrics after each section. CPM remains in charge of the
+// measurement loop and of its own report.
+
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <chrono>
+#include <algorithm>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "evb/alloc.hpp"
+#include "evb/cache.hpp"
+#include "evb/config.hpp"
+#include "evb/data.hpp"
+#include "evb/memory.hpp"
+#include "evb/numa.hpp"
+#include "evb/perf.hpp"
+#include "evb/roofline.hpp"
+#include "evb/threads.hpp"
+
+// The name of the build, set by the Makefile from the BLAS backend and the instruction set
+#ifndef EVB_BUILD_NAME
+#define EVB_BUILD_NAME "default"
+#endif
+
+namespace evb {
+
+using sizes_t = std::vector<std::size_t>;
+
+/*!
+ * \brief One measured variant of a library in a section
+ */
+struct variant {
+    std::string name;    ///< The name reported to CPM
+    std::string library; ///< The name of the library, as given in the section
+    std::size_t threads; ///< The number of threads to use
+};
+
+/*!
+ * \brief The measurements of one variant at one point of the size policy
+ */
+struct point {
+    variant var;
+    sizes_t sizes;
+    std::size_t calls = 0; ///< Number of calls of the measured lambda
+    double ns         = 0; ///< Total time spent in the measured lambda
+
+    std::vector<std::pair<std::string, std::string>> tags; ///< Descriptions of the point
+    std::vector<std::pair<std::string, double>> counters;  ///< Counters, summed over all the calls
+    perf_snapshot perf_start;                              ///< The hardware counters at the beginning of the point
+
+    std::vector<std::size_t> values;          ///< The number of values of each operand, see for_each_value
+    std::vector<std::vector<double>> samples; ///< Values of each operand after the first call, for the validation
+    std::vector<double> results;              ///< The scalar results kept during the first call, see keep
+    double epsilon = 0;                       ///< The machine epsilon of the least precise sampled value
+
+    double time() const {
+        return calls ? ns / calls : 0.0;
+    }
+
+    void tag(const std::string& name, const std::string& value){
+        for(auto& tag : tags){
+            if(tag.first == name){
+                tag.second = value;
+                return;
+            }
+        }
+
+        tags.emplace_back(name, value);
+    }
+
+    const std::string* tag(const std::string& name) const {
+        for(auto& tag : tags){
+            if(tag.first == name){
+                return &tag.second;
+            }
+        }
+
+        return nullptr;
+    }
+
+    void add_counter(const std::string& name, double value){
+        for(auto& counter : counters){
+            if(counter.first == name){
+                counter.second += value;
+                return;
+            }
+        }
+
+        counters.emplace_back(name, value);
+    }
+
+    const double* counter(const std::string& name) const {
+        for(auto& counter : counters){
+            if(counter.first == name){
+                return &counter.second;
+            }
+        }
+
+        return nullptr;
+    }
+};
+
+/*!
+ * \brief A function of the sizes of a point
+ */
+using size_function = std::function<double(const sizes_t&)>;
+
+namespace detail {
+
+template <typename F>
+struct arity : arity<decltype(&F::operator())> {};
+
+template <typename C, typename R, typename... A>
+struct arity<R (C::*)(A...) const> {
+    static constexpr std::size_t value = sizeof...(A);
+};
+
+template <typename F, std::size_t... I>
+double call_sizes(const F& f, const sizes_t& sizes, std::index_sequence<I...> /*seq*/){
+    return f(sizes[I]...);
+}
+
+} //end of namespace detail
+
+/*!
+ * \brief Make a size_function from a lambda taking the sizes of the policy as arguments
+ */
+template <typename F>
+size_function make_size_function(F f){
+    return [f](const sizes_t& sizes){
+        constexpr std::size_t N = detail::arity<F>::value;
+        return sizes.size() == N ? detail::call_sizes(f, sizes, std::make_index_sequence<N>()) : 0.0;
+    };
+}
+
+/*!
+ * \brief The cost of one iteration of a section, as a function of its sizes
+ */
+struct cost_model {
+    size_function flops; ///< Number of floating-point operations
+    size_function bytes; ///< Number of bytes to move from and to memory, at least
+    bool single;         ///< Indicates if the operations are in single-precision
+};
+
+/*!
+ * \brief The measurements of a full section
+ */
+struct section_record {
+    std::string name;
+    std::deque<point> points;
+    point* current = nullptr;
+    std::unique_ptr<cost_model> cost;
+    std::string items_name;  ///< The name of the items processed per iteration
+    size_function items;     ///< The number of items processed per iteration
+    std::string base_suffix; ///< The suffix of the variants used as base for the memory passes
+    size_function pass;      ///< The number of bytes of one memory pass
+    bool fill = true;        ///< Fill the operands with the configured data, see EVB_OWN_DATA
+
+    explicit section_record(std::string name) : name(std::move(name)) {}
+
+    const point* find(const std::string& library, const sizes_t& sizes, std::size_t threads) const {
+        for(auto& p : points){
+            if(p.var.library == library && p.sizes == sizes && p.var.threads == threads){
+                return &p;
+            }
+        }
+
+        return nullptr;
+    }
+};
+
+/*!
+ * \brief Return the record of the section currently running, if any
+ */
+inline std::unique_ptr<section_record>& current_section(){
+    static std::unique_ptr<section_record> section;
+    return section;
+}
+
+/*!
+ * \brief Return the point currently being measured, if any
+ */
+inline point* current_point(){
+    auto& section = current_section();
+    return section ? section->current : nullptr;
+}
+
+/*!
+ * \brief Describe the point currently being measured, the tags are reported as columns
+ */
+inline void tag(const std::string& name, const std::string& value){
+    if(auto* p = current_point()){
+        p->tag(name, value);
+    }
+}
+
+/*!
+ * \brief Prevent the compiler from removing the computation of the given value
+ *
+ * Used for the reductions, whose result is otherwise unused. The result of
+ * the first call is compared between the libraries (EVB_VALIDATE).
+ */
+template <typename T>
+inline void keep(const T& value){
+    if(get_config().validate){
+        auto* p = current_point();
+
+        if(p && !p->calls){
+            p->results.push_back(static_cast<double>(value));
+
+            if(std::is_floating_point<T>::value){
+                p->epsilon = std::max(p->epsilon, static_cast<double>(std::numeric_limits<T>::epsilon()));
+            }
+        }
+    }
+
+#if defined(__GNUC__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile char sink;
+    sink = *reinterpret_cast<const volatile char*>(&value);
+#endif
+}
+
+/*!
+ * \brief Return the variants to measure for the given library.
+ *
+ * The thread counts that a library cannot honour are collapsed: ETL has a
+ * single parallel variant, with the size of its pool.
+ */
+inline std::vector<variant> variants(const std::string& library){
+    auto& threads = get_config().threads;
+
+    if(threads.empty()){
+        return {{library, library, 1}};
+    }
+
+    std::vector<variant> vars;
+
+    for(auto requested : threads){
+        auto t = library_threads(library, requested);
+
+        if(std::none_of(vars.begin(), vars.end(), [t](const variant& v){ return v.threads == t; })){
+            vars.push_back({library + " [" + std::to_string(t) + "t]", library, t});
+        }
+    }
+
+    return vars;
+}
+
+inline bool perf_enabled(){
+    return get_config().perf && get_perf_counters().available();
+}
+
+/*!
+ * \brief Called once all the measurements of the current point are done
+ */
+inline void end_point(){
+    auto* p = current_point();
+
+    if(!p){
+        return;
+    }
+
+    if(perf_enabled()){
+        auto perf_end = get_perf_counters().read();
+
+        for(std::size_t i = 0; i < perf_end.size(); ++i){
+            p->add_counter(perf_end[i].first, perf_end[i].second - p->perf_start[i].second);
+        }
+    }
+
+    current_section()->current = nullptr;
+}
+
+/*!
+ * \brief Called before the initialization of the data of a new point
+ */
+inline void begin_point(const variant& var, sizes_t sizes){
+    auto& section = current_section();
+
+    if(!section){
+        return;
+    }
+
+    end_point();
+
+    set_threads(var.threads);
+
+    section->points.emplace_back();
+    section->current = &section->points.back();
+    section->current->var   = var;
+    section->current->sizes = std::move(sizes);
+
+    if(perf_enabled()){
+        section->current->perf_start = get_perf_counters().read();
+    }
+}
+
+/*!
+ * \brief Run the measured functor once and account it to the current point
+ */
+template <typename Functor>
+inline void measure(Functor&& functor){
+    using clock = std::chrono::steady_clock;
+
+    bool perf  = perf_enabled();
+    bool alloc = get_config().alloc && alloc_available();
+
+    if(alloc){
+        alloc_start();
+    }
+
+    if(perf){
+        get_perf_counters().start();
+    }
+
+    auto start = clock::now();
+    functor();
+    auto end = clock::now();
+
+    if(perf){
+        get_perf_counters().stop();
+    }
+
+    alloc_stats stats;
+
+    if(alloc){
+        stats = alloc_stop();
+    }
+
+    if(auto* p = current_point()){
+        ++p->calls;
+        p->ns += std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+        if(alloc){
+            p->add_counter("allocs", stats.allocs);
+            p->add_counter("alloc bytes", stats.bytes);
+            p->add_counter("peak bytes", stats.peak);
+        }
+    }
+}
+
+inline std::string format_sizes(const sizes_t& sizes){
+    std::string s;
+
+    for(auto d : sizes){
+        s += (s.empty() ? "" : "x") + std::to_string(d);
+    }
+
+    return s;
+}
+
+inline std::string format_time(double ns){
+    char buffer[32];
+
+    if(ns < 1e3){
+        std::snprintf(buffer, sizeof(buffer), "%.1fns", ns);
+    } else if(ns < 1e6){
+        std::snprintf(buffer, sizeof(buffer), "%.2fus", ns / 1e3);
+    } else if(ns < 1e9){
+        std::snprintf(buffer, sizeof(buffer), "%.2fms", ns / 1e6);
+    } else {
+        std::snprintf(buffer, sizeof(buffer), "%.2fs", ns / 1e9);
+    }
+
+    return buffer;
+}
+
+inline std::string format_count(double value){
+    char buffer[32];
+
+    if(value < 1e3){
+        std::snprintf(buffer, sizeof(buffer), "%.1f", value);
+    } else if(value < 1e6){
+        std::snprintf(buffer, sizeof(buffer), "%.2fK", value / 1e3);
+    } else if(value < 1e9){
+        std::snprintf(buffer, sizeof(buffer), "%.2fM", value / 1e6);
+    } else {
+        std::snprintf(buffer, sizeof(buffer), "%.2fG", value / 1e9);
+    }
+
+    return buffer;
+}
+
+inline std::string format_bytes(double bytes){
+    char buffer[32];
+
+    if(bytes < 1024){
+        std::snprintf(buffer, sizeof(buffer), "%.0fB", bytes);
+    } else if(bytes < 1024 * 1024){
+        std::snprintf(buffer, sizeof(buffer), "%.1fKiB", bytes / 1024);
+    } else if(bytes < 1024 * 1024 * 1024){
+        std::snprintf(buffer, sizeof(buffer), "%.1fMiB", bytes / (1024 * 1024));
+    } else {
+        std::snprintf(buffer, sizeof(buffer), "%.2fGiB", bytes / (1024 * 1024 * 1024));
+    }
+
+    return buffer;
+}
+
+inline std::string format_double(double value, const char* format = "%.2f"){
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), format, value);
+    return buffer;
+}
+
+/*!
+ * \brief A simple text table, with columns sized to their content
+ */
+struct table {
+    std::vector<std::string> header;
+    std::vector<std::vector<std::string>> rows;
+
+    explicit table(std::vector<std::string> header) : header(std::move(header)) {}
+
+    void add(std::vector<std::string> row){
+        rows.push_back(std::move(row));
+    }
+
+    void print() const {
+        std::vector<std::size_t> widths(header.size());
+
+        for(std::size_t c = 0; c < header.size(); ++c){
+            widths[c] = header[c].size();
+
+            for(auto& row : rows){
+                widths[c] = std::max(widths[c], row[c].size());
+            }
+        }
+
+        auto print_row = [&widths](const std::vector<std::string>& row){
+            std::printf(" ");
+
+            for(std::size_t c = 0; c < row.size(); ++c){
+                std::printf(c ? " %*s" : " %-*s", static_cast<int>(widths[c]), row[c].c_str());
+            }
+
+            std::printf("\n");
+        };
+
+        print_row(header);
+
+        for(auto& row : rows){
+            print_row(row);
+        }
+    }
+};
+
+/*!
+ * \brief Print the report of a finished section
+ */
+inline void report(const section_record& section){
+    auto& threads = get_config().threads;
+    bool threaded = !threads.empty();
+
+    auto* cost = section.cost.get();
+    bool roofline = cost && get_config().roofline;
+
+    if(roofline){
+        for(auto& p : section.points){
+            get_roof(p.var.threads);
+        }
+    }
+
+    std::vector<std::string> tags;
+
+    for(auto& p : section.points){
+        for(auto& tag : p.tags){
+            if(std::find(tags.begin(), tags.end(), tag.first) == tags.end()){
+                tags.push_back(tag.first);
+            }
+        }
+    }
+
+    std::vector<std::string> header{"variant", "size"};
+
+    header.insert(header.end(), tags.begin(), tags.end());
+    header.push_back("time");
+
+    if(threaded){
+        header.insert(header.end(), {"threads", "speedup", "efficiency"});
+    }
+
+    if(cost){
+        header.insert(header.end(), {"GFLOP/s", "GB/s"});
+    }
+
+    if(roofline){
+        header.push_back("%roof");
+    }
+
+    if(section.items){
+        header.push_back(section.items_name + "/s");
+    }
+
+    if(section.pass){
+        header.push_back("passes");
+    }
+
+    // Counters are reported per iteration
+    std::vector<std::string> counters;
+
+    for(auto& p : section.points){
+        for(auto& counter : p.counters){
+            if(std::find(counters.begin(), counters.end(), counter.first) == counters.end()){
+                counters.push_back(counter.first);
+            }
+        }
+    }
+
+    bool ipc = std::find(counters.begin(), counters.end(), "cycles") != counters.end()
+            && std::find(counters.begin(), counters.end(), "instructions") != counters.end();
+
+    header.insert(header.end(), counters.begin(), counters.end());
+
+    if(ipc){
+        header.push_back("IPC");
+    }
+
+    table t(header);
+
+    for(auto& p : section.points){
+        if(!p.calls){
+            continue;
+        }
+
+        std::vector<std::string> row{p.var.name, format_sizes(p.sizes)};
+
+        for(auto& name : tags){
+            auto* value = p.tag(name);
+            row.push_back(value ? *value : "-");
+        }
+
+        row.push_back(format_time(p.time()));
+
+        if(threaded){
+            // Speedup is relative to the smallest thread count of the library in the sweep
+            auto base_threads = library_threads(p.var.library, *std::min_element(threads.begin(), threads.end()));
+            auto* base        = section.find(p.var.library, p.sizes, base_threads);
+            double speedup    = base && base->calls ? base->time() / p.time() : 0.0;
+
+            row.push_back(std::to_string(p.var.threads));
+            row.push_back(format_double(speedup));
+            row.push_back(format_double(100.0 * speedup * base_threads / p.var.threads, "%.0f%%"));
+        }
+
+        if(cost){
+            double flops = cost->flops(p.sizes);
+            double bytes = cost->bytes(p.sizes);
+
+            row.push_back(flops > 0 ? format_double(flops / p.time()) : "-");
+            row.push_back(format_double(bytes / p.time()));
+
+            if(roofline){
+                // The fraction of the lower bound of time given by the roofline
+                auto& r      = get_roof(p.var.threads);
+                double peak  = cost->single ? r.peak_single : r.peak_double;
+                double bound = std::max(flops / peak, bytes / r.bandwidth) * 1e9;
+
+                row.push_back(format_double(100.0 * bound / p.time(), "%.1f%%"));
+            }
+        }
+
+        if(section.items){
+            row.push_back(format_count(section.items(p.sizes) / p.time() * 1e9));
+        }
+
+        if(section.pass){
+            // The time spent beyond the base variant, in memory passes at the bandwidth of main memory
+            auto* base = section.find(p.var.library + section.base_suffix, p.sizes, p.var.threads);
+
+            if(base && base->calls){
+                double extra = (p.time() - base->time()) * 1e-9 * get_roof(p.var.threads).bandwidth;
+                row.push_back(format_double(extra / section.pass(p.sizes), "%.1f"));
+            } else {
+                row.push_back("-");
+            }
+        }
+
+        for(auto& name : counters){
+            auto* value = p.counter(name);
+            row.push_back(value ? format_count(*value / p.calls) : "-");
+        }
+
+        if(ipc){
+            auto* cycles       = p.counter("cycles");
+            auto* instructions = p.counter("instructions");
+            row.push_back(cycles && instructions && *cycles > 0 ? format_double(*instructions / *cycles) : "-");
+        }
+
+        t.add(std::move(row));
+    }
+
+    std::printf("\n[evb] %s%s\n", section.name.c_str(), get_config().cold ? " (cold)" : "");
+    t.print();
+    std::printf("\n");
+}
+
+inline std::string csv_field(const std::string& value){
+    std::string field = "\"";
+
+    for(auto c : value){
+        field += c == '"' ? "\"\"" : std::string(1, c);
+    }
+
+    return field + "\"";
+}
+
+/*!
+ * \brief Append the results of a finished section to a CSV file.
+ *
+ * There is one line per metric of each point, so that the results of
+ * several builds and runs can simply be concatenated.
+ */
+inline void write_csv(const section_record& section, const std::string& path){
+    std::ofstream stream(path, std::ios::app);
+
+    if(!stream){
+        std::fprintf(stderr, "[evb] cannot write %s\n", path.c_str());
+        return;
+    }
+
+    if(stream.tellp() == 0){
+        stream << "build,section,library,threads,size,metric,value\n";
+    }
+
+    for(auto& p : section.points){
+        if(!p.calls){
+            continue;
+        }
+
+        auto write = [&](const std::string& metric, const std::string& value){
+            stream << csv_field(EVB_BUILD_NAME) << ',' << csv_field(section.name) << ',' << csv_field(p.var.library) << ','
+                   << p.var.threads << ',' << csv_field(format_sizes(p.sizes)) << ',' << csv_field(metric) << ',' << csv_field(value) << '\n';
+        };
+
+        write("time_ns", format_double(p.time(), "%.1f"));
+
+        if(auto* cost = section.cost.get()){
+            write("gflops", format_double(cost->flops(p.sizes) / p.time(), "%.3f"));
+            write("gbps", format_double(cost->bytes(p.sizes) / p.time(), "%.3f"));
+        }
+
+        if(section.items){
+            write(section.items_name + "_per_s", format_double(section.items(p.sizes) / p.time() * 1e9, "%.1f"));
+        }
+
+        for(auto& tag : p.tags){
+            write(tag.first, tag.second);
+        }
+
+        for(auto& counter : p.counters){
+            write(counter.first, format_double(counter.second / p.calls, "%.1f"));
+        }
+    }
+}
+
+namespace detail {
+
+// The largest finite magnitude of the values
+inline double scale(const std::vector<double>& a, const std::vector<double>& b){
+    double scale = 0.0;
+
+    for(auto* values : {&a, &b}){
+        for(auto v : *values){
+            if(std::isfinite(v)){
+                scale = std::max(scale, std::abs(v));
+            }
+        }
+    }
+
+    return scale;
+}
+
+// The index of the first value of a that differs from b, normwise, or the size of a
+inline std::size_t mismatch(const std::vector<double>& a, const std::vector<double>& b, double tolerance){
+    const double s = scale(a, b);
+
+    for(std::size_t i = 0; i < a.size(); ++i){
+        bool same;
+
+        if(std::isnan(a[i]) || std::isnan(b[i])){
+            same = std::isnan(a[i]) && std::isnan(b[i]);
+        } else if(std::isinf(a[i]) || std::isinf(b[i])){
+            same = a[i] == b[i];
+        } else {
+            same = std::abs(a[i] - b[i]) <= tolerance * s;
+        }
+
+        if(!same){
+            return i;
+        }
+    }
+
+    return a.size();
+}
+
+} //end of namespace detail
+
+/*!
+ * \brief Compare the operands and results of the points of a finished section.
+ *
+ * The points with the same sizes, thread count and operands (in number of
+ * values) are compared to the first of them, tagged "ref" in the "check"
+ * column, and tagged "ok" or "FAIL". The differences are also printed.
+ */
+inline void validate(section_record& section){
+    auto& config = get_config();
+
+    for(auto& p : section.points){
+        if(std::all_of(p.values.begin(), p.values.end(), [](std::size_t n){ return n == 0; }) && p.results.empty()){
+            continue;
+        }
+
+        point* ref = nullptr;
+
+        for(auto& q : section.points){
+            if(&q == &p){
+                break;
+            }
+
+            if(q.sizes == p.sizes && q.var.threads == p.var.threads && q.values == p.values && q.results.size() == p.results.size()){
+                ref = &q;
+                break;
+            }
+        }
+
+        if(!ref){
+            continue;
+        }
+
+        if(!ref->tag("check")){
+            ref->tag("check", "ref");
+        }
+
+        // By default, half of the digits of the least precise type must be the same
+        double tolerance = config.tolerance > 0 ? config.tolerance : std::sqrt(std::max(p.epsilon, ref->epsilon));
+
+        auto check = [&](const char* what, std::size_t k, const std::vector<double>& values, const std::vector<double>& reference){
+            auto i = detail::mismatch(values, reference, tolerance);
+
+            if(i < values.size()){
+                std::fprintf(stderr, "[evb] %s: %s differs from %s at %s, %s %zu, sample %zu: %g instead of %g\n",
+                             section.name.c_str(), p.var.name.c_str(), ref->var.name.c_str(), format_sizes(p.sizes).c_str(), what, k, i, values[i], reference[i]);
+                return false;
+            }
+
+            return true;
+        };
+
+        bool ok = check("result", 0, p.results, ref->results);
+
+        for(std::size_t k = 0; ok && k < p.samples.size(); ++k){
+            ok = check("operand", k, p.samples[k], ref->samples[k]);
+        }
+
+        p.tag("check", ok ? "ok" : "FAIL");
+    }
+}
+
+/*!
+ * \brief Scope of a section, opened by EVB_SECTION_P
+ */
+struct section_scope {
+    explicit section_scope(const char* name){
+        current_section().reset(new section_record(name));
+    }
+
+    /*!
+     * \brief Set the cost model of the section, see EVB_COST
+     */
+    template <typename T, typename Flops, typename Bytes>
+    void cost(Flops flops, Bytes bytes){
+        current_section()->cost.reset(new cost_model{make_size_function(flops), make_size_function(bytes), sizeof(T) == 4});
+    }
+
+    /*!
+     * \brief Set the number of items processed per iteration, see EVB_ITEMS
+     */
+    template <typename Items>
+    void items(const std::string& name, Items items){
+        current_section()->items_name = name;
+        current_section()->items      = make_size_function(items);
+    }
+
+    /*!
+     * \brief Estimate the memory passes of each variant beyond its base variant, see EVB_PASSES
+     */
+    template <typename Bytes>
+    void passes(const std::string& suffix, Bytes bytes){
+        current_section()->base_suffix = suffix;
+        current_section()->pass        = make_size_function(bytes);
+    }
+
+    /*!
+     * \brief Keep the operands built by the initialization functors, see EVB_OWN_DATA
+     */
+    void own_data(){
+        current_section()->fill = false;
+    }
+
+    ~section_scope(){
+        end_point();
+
+        if(get_config().validate){
+            validate(*current_section());
+        }
+
+        if(get_config().report && !current_section()->points.empty()){
+            report(*current_section());
+        }
+
+        if(!get_config().csv.empty()){
+            write_csv(*current_section(), get_config().csv);
+        }
+
+        current_section().reset();
+    }
+};
+
+/*!
+ * \brief Fill the operands with the configured data, the same for every library
+ */
+template <typename Tuple, std::size_t... I>
+void fill_containers(Tuple&& containers, std::index_sequence<I...> /*seq*/){
+    auto& config = get_config();
+
+    int filled[] = {0, (evb::fill(std::get<I>(containers), config.data, config.seed + I), 0)...};
+    (void)filled;
+}
+
+template <typename Tuple, std::size_t... I>
+void fill_operands(Tuple& operands, std::index_sequence<I...> /*seq*/){
+    auto& section = current_section();
+
+    if(section && !section->fill){
+        return;
+    }
+
+    // The containers of all the operands are numbered in order for the seeds
+    auto containers = std::tuple_cat(operands_of(std::get<I>(operands))...);
+    fill_containers(containers, std::make_index_sequence<std::tuple_size<decltype(containers)>::value>());
+}
+
+/*!
+ * \brief Wrap the initialization functor of a section to start a new point
+ */
+template <typename Init, typename Functor>
+auto wrap_init(const variant& var, Init init, Functor /*functor*/){
+    return [var, init](auto... sizes){
+        begin_point(var, {static_cast<std::size_t>(sizes)...});
+
+        auto operands = init(sizes...);
+        fill_operands(operands, std::make_index_sequence<std::tuple_size<decltype(operands)>::value>());
+        return operands;
+    };
+}
+
+/*!
+ * \brief Tag the point with the working set of its operands and the cache level that holds it
+ */
+template <typename... T>
+void tag_working_set(point& p, const T&... args){
+    std::size_t bytes = 0;
+    bool known        = false;
+
+    for_each_memory([&](const memory_range& range){
+        bytes += range.bytes();
+        known = true;
+    }, args...);
+
+    if(known){
+        p.tag("working set", format_bytes(bytes));
+        p.tag("level", cache_level_name(bytes));
+    }
+}
+
+/*!
+ * \brief Move the operands to the nodes of EVB_NUMA and tag the point with the nodes that hold them
+ */
+template <typename... T>
+void place_operands(point& p, const T&... args){
+    std::vector<memory_range> ranges;
+
+    for_each_memory([&](const memory_range& range){
+        place_memory(range);
+        ranges.push_back(range);
+    }, args...);
+
+    auto placement = memory_placement(ranges);
+
+    if(!placement.empty()){
+        p.tag("numa", placement);
+    }
+}
+
+// The number of values of each operand compared between the libraries
+constexpr std::size_t validation_samples = 64;
+
+/*!
+ * \brief Keep regularly spaced values of the operand for the validation
+ */
+template <typename T>
+void sample_operand(point& p, T& value){
+    std::size_t n = for_each_value(value, [](auto& /*v*/){});
+
+    p.values.push_back(n);
+    p.samples.emplace_back();
+
+    auto& samples      = p.samples.back();
+    std::size_t stride = std::max<std::size_t>(1, n / validation_samples);
+    std::size_t i      = 0;
+
+    for_each_value(value, [&](auto& v){
+        if(i++ % stride == 0){
+            samples.push_back(static_cast<double>(v));
+            p.epsilon = std::max(p.epsilon, static_cast<double>(std::numeric_limits<std::decay_t<decltype(v)>>::epsilon()));
+        }
+    });
+}
+
+template <typename Tuple, std::size_t... I>
+void sample_containers(point& p, Tuple&& containers, std::index_sequence<I...> /*seq*/){
+    int sampled[] = {0, (sample_operand(p, std::get<I>(containers)), 0)...};
+    (void)sampled;
+}
+
+/*!
+ * \brief Keep samples of the containers of all the operands for the validation
+ */
+template <typename... T>
+void sample_operands(point& p, T&... args){
+    auto containers = std::tuple_cat(operands_of(args)...);
+    sample_containers(p, containers, std::make_index_sequence<std::tuple_size<decltype(containers)>::value>());
+}
+
+/*!
+ * \brief Wrap the measured functor of a section
+ */
+template <typename Init, typename Functor>
+auto wrap_functor(const variant& /*var*/, Init /*init*/, Functor functor){
+    return [functor](auto&... args){
+        auto* p = current_point();
+
+        if(p && !p->calls){
+            tag_working_set(*p, args...);
+
+            if(!get_config().cpus.empty()){
+                p->tag("cpus", env_string("EVB_CPUS"));
+            }
+
+            if(!get_config().numa.empty()){
+                place_operands(*p, args...);
+            }
+        }
+
+        // The eviction is done outside of the measure
+        if(get_config().cold){
+            evict(args...);
+        }
+
+        measure([&](){ functor(args...); });
+
+        // The state after exactly one call is the same for every library
+        if(p && p->calls == 1 && get_config().validate){
+            sample_operands(*p, args...);
+        }
+    };
+}
+
+} //end of namespace evb
+
+/*!
+ * \brief Open a section, see CPM_SECTION_P
+ */
+#define EVB_SECTION_P(name, ...)    \
+    CPM_SECTION_P(name, __VA_ARGS__) \
+    evb::section_scope evb_section(name);
+
+/*!
+ * \brief Set the cost model of the current section.
+ *
+ * The first argument is the value type, followed by the number of FLOPs and
+ * the number of bytes per iteration, as functions of the sizes.
+ */
+#define EVB_COST(T, ...) evb_section.cost<T>(__VA_ARGS__)
+
+/*!
+ * \brief Set the number of items processed per iteration in the current
+ * section, reported as a throughput.
+ */
+#define EVB_ITEMS(name, ...) evb_section.items(name, __VA_ARGS__)
+
+/*!
+ * \brief Keep the operands built by the initialization functors of the
+ * current section, instead of filling them with the data of EVB_DATA.
+ */
+#define EVB_OWN_DATA() evb_section.own_data()
+
+/*!
+ * \brief Estimate the number of full memory passes made by each variant of
+ * the current section beyond its base variant, the variant with the same
+ * name followed by the given suffix, for instance "etl" and "etl-gemm".
+ *
+ * The difference of time is converted with the bandwidth of main memory
+ * (see evb/roofline.hpp) and divided by the bytes of one pass, given as a
+ * function of the sizes.
+ */
+#define EVB_PASSES(suffix, ...) evb_section.passes(suffix, __VA_ARGS__)
+
+/*!
+ * \brief Measure a library in the current section, see CPM_TWO_PASS_NS.
+ *
+ * The library is measured once per configured thread count.
+ */
+#define EVB_TWO_PASS_NS(library, ...)                                    \
+    for(auto& evb_variant : evb::variants(library)){                     \
+        CPM_TWO_PASS_NS(evb_variant.name,                                \
+            evb::wrap_init(evb_variant, __VA_ARGS__),                    \
+            evb::wrap_functor(evb_variant, __VA_ARGS__));                \
+    }
@@ -0,0 +1,107 @@
+#pragma once
+
+// Access to the memory of the operands of the measured lambdas, whatever
+// their library: ETL containers (memory_start/memory_end), Blaze dense
+// containers and std::vector (data/capacity) and Eigen dense containers
+// (data/size). Other operands (sparse matrices, pointers, ...) have no
+// known memory.
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace evb {
+
+/*!
+ * \brief A contiguous range of memory
+ */
+struct memory_range {
+    const char* begin = nullptr;
+    const char* end   = nullptr;
+
+    std::size_t bytes() const {
+        return end - begin;
+    }
+
+    explicit operator bool() const {
+        return begin != end;
+    }
+};
+
+namespace detail {
+
+// Only containers whose data() is a pointer are contiguous, the data() of
+// Eigen's sparse matrices returns their compressed storage
+template <typename T>
+using pointer_data_t = std::enable_if_t<std::is_pointer<decltype(std::declval<const T&>().data())>::value, memory_range>;
+
+// Priority tags to select the first matching overload
+template <std::size_t N>
+struct priority : priority<N - 1> {};
+
+template <>
+struct priority<0> {};
+
+template <typename T>
+auto memory_of(const T& value, priority<3> /*p*/) -> decltype(value.memory_start(), value.memory_end(), memory_range()){
+    return {reinterpret_cast<const char*>(value.memory_start()), reinterpret_cast<const char*>(value.memory_end())};
+}
+
+template <typename T>
+auto memory_of(const T& value, priority<2> /*p*/) -> decltype(value.capacity(), pointer_data_t<T>()){
+    auto* data = reinterpret_cast<const char*>(value.data());
+    return {data, data + value.capacity() * sizeof(*value.data())};
+}
+
+template <typename T>
+auto memory_of(const T& value, priority<1> /*p*/) -> decltype(value.size(), pointer_data_t<T>()){
+    auto* data = reinterpret_cast<const char*>(value.data());
+    return {data, data + value.size() * sizeof(*value.data())};
+}
+
+template <typename T>
+memory_range memory_of(const T& /*value*/, priority<0> /*p*/){
+    return {};
+}
+
+} //end of namespace detail
+
+/*!
+ * \brief Return the memory of the given operand, empty if unknown
+ */
+template <typename T>
+memory_range memory_of(const T& value){
+    return detail::memory_of(value, detail::priority<3>());
+}
+
+/*!
+ * \brief Call the functor on the memory of each operand with a known memory
+ */
+template <typename Functor, typename... T>
+void for_each_memory(Functor&& functor, const T&... values){
+    memory_range ranges[] = {memory_range(), memory_of(values)...};
+
+    for(auto& range : ranges){
+        if(range){
+            functor(range);
+        }
+    }
+}
+
+/*!
+ * \brief Indicates if all the operands have a known memory
+ */
+template <typename... T>
+bool all_memory_known(const T&... values){
+    bool known[] = {true, static_cast<bool>(memory_of(values))...};
+
+    for(auto k : known){
+        if(!k){
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} //end of namespace evb
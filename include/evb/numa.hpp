@@ -0,0 +1,314 @@
+#pragma once
+
+// Pinning of the threads and placement of the operands on the NUMA nodes.
+//
+// With EVB_CPUS, the process is restricted to the given CPUs before the
+// static initialization of the libraries (src/numa.cpp), so that the threads
+// they create, like ETL's thread pool, stay in the set, and each OpenMP
+// worker is pinned to one of the CPUs. With EVB_NUMA, the pages of the operands are moved to the
+// selected nodes with mbind before they are measured, and the nodes that
+// actually hold them are reported. The system calls are used directly, so
+// libnuma is not needed. Outside of Linux, both modes are ignored.
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "evb/config.hpp"
+#include "evb/memory.hpp"
+
+namespace evb {
+
+#ifdef __linux__
+
+/*!
+ * \brief The NUMA nodes of the machine and their CPUs
+ */
+struct numa_topology {
+    std::vector<std::size_t> nodes;                 ///< The online nodes
+    std::map<std::size_t, std::size_t> node_of_cpu; ///< The node of each CPU
+
+    numa_topology(){
+        const std::string base = "/sys/devices/system/node/";
+
+        nodes = parse_list(read_line(base + "online"));
+
+        for(auto node : nodes){
+            for(auto cpu : parse_list(read_line(base + "node" + std::to_string(node) + "/cpulist"))){
+                node_of_cpu[cpu] = node;
+            }
+        }
+
+        // Kernels without NUMA support have no node directory
+        if(nodes.empty()){
+            nodes.push_back(0);
+        }
+    }
+
+    /*!
+     * \brief Return the node of the given CPU
+     */
+    std::size_t node(std::size_t cpu) const {
+        auto it = node_of_cpu.find(cpu);
+        return it == node_of_cpu.end() ? nodes.front() : it->second;
+    }
+
+private:
+    static std::string read_line(const std::string& path){
+        std::ifstream stream(path);
+        std::string value;
+        std::getline(stream, value);
+        return value;
+    }
+};
+
+/*!
+ * \brief Return the NUMA topology of the machine
+ */
+inline const numa_topology& get_numa_topology(){
+    static numa_topology topology;
+    return topology;
+}
+
+namespace detail {
+
+inline void pin_current_thread(const std::vector<std::size_t>& cpus){
+    cpu_set_t set;
+    CPU_ZERO(&set);
+
+    for(auto cpu : cpus){
+        CPU_SET(cpu, &set);
+    }
+
+    if(sched_setaffinity(0, sizeof(set), &set) != 0){
+        static bool warned = false;
+
+        if(!warned){
+            std::fprintf(stderr, "[evb] cannot pin the threads (%s)\n", std::strerror(errno));
+            warned = true;
+        }
+    }
+}
+
+} //end of namespace detail
+
+/*!
+ * \brief Restrict the calling thread, and the threads it creates afterwards, to the CPUs of EVB_CPUS
+ */
+inline void restrict_threads(){
+    auto& cpus = get_config().cpus;
+
+    if(!cpus.empty()){
+        detail::pin_current_thread(cpus);
+    }
+}
+
+/*!
+ * \brief Pin the threads to the CPUs of EVB_CPUS, for a run with n threads.
+ *
+ * The OpenMP workers are pinned each to one CPU of the set, in order. The
+ * main thread, the first OpenMP thread, keeps the whole set, so that the
+ * threads it creates (BLAS threads outside of OpenMP) are not all confined
+ * to a single CPU.
+ */
+inline void pin_threads(std::size_t n){
+    auto& cpus = get_config().cpus;
+
+    if(cpus.empty()){
+        return;
+    }
+
+    restrict_threads();
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(n)
+    {
+        std::size_t t = omp_get_thread_num();
+
+        if(t > 0){
+            detail::pin_current_thread({cpus[t % cpus.size()]});
+        }
+    }
+#else
+    (void)n;
+#endif
+}
+
+/*!
+ * \brief A placement of memory: a policy of mbind and its nodes
+ */
+struct numa_policy {
+    int mode = MPOL_DEFAULT;
+    std::vector<std::size_t> nodes;
+};
+
+namespace detail {
+
+inline numa_policy parse_numa_policy(const std::string& value){
+    auto& topology = get_numa_topology();
+    auto& cpus     = get_config().cpus;
+
+    // The local node is the one of the first CPU the threads run on
+    int cpu           = cpus.empty() ? sched_getcpu() : static_cast<int>(cpus.front());
+    std::size_t local = topology.node(cpu < 0 ? 0 : cpu);
+
+    numa_policy policy;
+
+    if(value == "local"){
+        policy.mode  = MPOL_BIND;
+        policy.nodes = {local};
+    } else if(value == "remote"){
+        for(auto node : topology.nodes){
+            if(node != local){
+                policy.mode  = MPOL_BIND;
+                policy.nodes = {node};
+                break;
+            }
+        }
+
+        if(policy.nodes.empty()){
+            std::fprintf(stderr, "[evb] EVB_NUMA=remote: no remote node, the operands are left in place\n");
+        }
+    } else if(value == "interleave"){
+        policy.mode  = MPOL_INTERLEAVE;
+        policy.nodes = topology.nodes;
+    } else if(!value.empty() && value.find_first_not_of("0123456789,-") == std::string::npos){
+        policy.mode  = MPOL_BIND;
+        policy.nodes = parse_list(value);
+    } else if(!value.empty()){
+        std::fprintf(stderr, "[evb] unknown EVB_NUMA value \"%s\", the operands are left in place\n", value.c_str());
+    }
+
+    return policy;
+}
+
+} //end of namespace detail
+
+/*!
+ * \brief Return the placement selected by EVB_NUMA
+ */
+inline const numa_policy& get_numa_policy(){
+    static numa_policy policy = detail::parse_numa_policy(get_config().numa);
+    return policy;
+}
+
+/*!
+ * \brief Move the pages of the given memory to the nodes of EVB_NUMA.
+ *
+ * The range is extended to whole pages, the neighbouring data sharing the
+ * first and last pages is moved as well.
+ */
+inline void place_memory(const memory_range& range){
+    auto& policy = get_numa_policy();
+
+    if(policy.nodes.empty()){
+        return;
+    }
+
+    static const std::uintptr_t page = sysconf(_SC_PAGESIZE);
+
+    auto begin = reinterpret_cast<std::uintptr_t>(range.begin) & ~(page - 1);
+    auto end   = (reinterpret_cast<std::uintptr_t>(range.end) + page - 1) & ~(page - 1);
+
+    constexpr std::size_t max_nodes = 1024;
+    constexpr std::size_t bits      = 8 * sizeof(unsigned long);
+
+    unsigned long mask[max_nodes / bits] = {};
+
+    for(auto node : policy.nodes){
+        if(node < max_nodes){
+            mask[node / bits] |= 1UL << (node % bits);
+        }
+    }
+
+    if(syscall(SYS_mbind, begin, end - begin, policy.mode, mask, max_nodes, MPOL_MF_MOVE) != 0){
+        static bool warned = false;
+
+        if(!warned){
+            std::fprintf(stderr, "[evb] cannot place the operands (%s)\n", std::strerror(errno));
+            warned = true;
+        }
+    }
+}
+
+/*!
+ * \brief Return the share of the pages of the given memory held by each node, for instance "0:50% 1:50%"
+ */
+inline std::string memory_placement(const std::vector<memory_range>& ranges){
+    // The number of pages whose node is queried in each range
+    constexpr std::size_t samples = 64;
+
+    static const std::uintptr_t page = sysconf(_SC_PAGESIZE);
+
+    std::vector<void*> pages;
+
+    for(auto& range : ranges){
+        auto begin = reinterpret_cast<std::uintptr_t>(range.begin) & ~(page - 1);
+        auto end   = reinterpret_cast<std::uintptr_t>(range.end);
+        auto n     = (end - begin + page - 1) / page;
+        auto step  = std::max<std::size_t>(1, n / samples);
+
+        for(std::size_t i = 0; i < n; i += step){
+            pages.push_back(reinterpret_cast<void*>(begin + i * page));
+        }
+    }
+
+    std::vector<int> status(pages.size(), -1);
+
+    if(pages.empty() || syscall(SYS_move_pages, 0, pages.size(), pages.data(), nullptr, status.data(), 0) != 0){
+        return "";
+    }
+
+    std::map<int, std::size_t> counts;
+    std::size_t total = 0;
+
+    // Pages that are not present have a negative status
+    for(auto node : status){
+        if(node >= 0){
+            ++counts[node];
+            ++total;
+        }
+    }
+
+    std::string placement;
+
+    for(auto& count : counts){
+        placement += (placement.empty() ? "" : " ") + std::to_string(count.first) + ":" + std::to_string(100 * count.second / total) + "%";
+    }
+
+    return placement;
+}
+
+#else
+
+inline void restrict_threads(){}
+
+inline void pin_threads(std::size_t /*n*/){}
+
+inline void place_memory(const memory_range& /*range*/){}
+
+inline std::string memory_placement(const std::vector<memory_range>& /*ranges*/){
+    return "";
+}
+
+#endif
+
+} //end of namespace evb
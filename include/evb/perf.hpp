@@ -0,0 +1,160 @@
+#pragma once
+
+// Hardware counters around the measured lambdas, using perf_event_open.
+//
+// The counters are opened once, disabled, and are only enabled around each
+// call of the measured lambda. Counters are inherited by the threads created
+// after they have been opened. When the counters cannot be opened (no
+// permission, no PMU in containers or VMs, not Linux), the harness only
+// reports time.
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace evb {
+
+/*!
+ * \brief A snapshot of the counters, one value per opened event
+ */
+using perf_snapshot = std::vector<std::pair<std::string, double>>;
+
+#ifdef __linux__
+
+/*!
+ * \brief A set of hardware counters counting the calling thread and its children
+ */
+struct perf_counters {
+    struct event {
+        std::string name;
+        int fd;
+    };
+
+    std::vector<event> events;
+
+    perf_counters(){
+        constexpr auto read_miss = (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+
+        open("cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+        open("instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        open("L1D-miss", PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | read_miss);
+        open("LLC-miss", PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_LL | read_miss);
+        open("dTLB-miss", PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB | read_miss);
+        open("branch-miss", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+
+        if(events.empty()){
+            std::fprintf(stderr, "[evb] no hardware counters available, reporting time only\n");
+        }
+    }
+
+    perf_counters(const perf_counters&) = delete;
+    perf_counters& operator=(const perf_counters&) = delete;
+
+    ~perf_counters(){
+        for(auto& e : events){
+            close(e.fd);
+        }
+    }
+
+    bool available() const {
+        return !events.empty();
+    }
+
+    void start(){
+        prctl(PR_TASK_PERF_EVENTS_ENABLE);
+    }
+
+    void stop(){
+        prctl(PR_TASK_PERF_EVENTS_DISABLE);
+    }
+
+    /*!
+     * \brief Read the current value of all the counters.
+     *
+     * When the PMU is multiplexed, the values are scaled by the fraction of
+     * time each counter was actually running.
+     */
+    perf_snapshot read() const {
+        perf_snapshot snapshot;
+
+        for(auto& e : events){
+            std::uint64_t values[3] = {0, 0, 0}; // value, time enabled, time running
+
+            double value = 0.0;
+
+            if(::read(e.fd, values, sizeof(values)) == sizeof(values) && values[2]){
+                value = static_cast<double>(values[0]) * values[1] / values[2];
+            }
+
+            snapshot.emplace_back(e.name, value);
+        }
+
+        return snapshot;
+    }
+
+private:
+    void open(const char* name, std::uint32_t type, std::uint64_t config){
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+
+        attr.size           = sizeof(attr);
+        attr.type           = type;
+        attr.config         = config;
+        attr.disabled       = 1;
+        attr.inherit        = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv     = 1;
+        attr.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        int fd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+
+        if(fd < 0){
+            std::fprintf(stderr, "[evb] perf counter %s unavailable: %s\n", name, std::strerror(errno));
+            return;
+        }
+
+        events.push_back({name, fd});
+    }
+};
+
+#else
+
+struct perf_counters {
+    perf_counters(){
+        std::fprintf(stderr, "[evb] perf counters are only supported on Linux\n");
+    }
+
+    bool available() const {
+        return false;
+    }
+
+    void start(){}
+    void stop(){}
+
+    perf_snapshot read() const {
+        return {};
+    }
+};
+
+#endif
+
+/*!
+ * \brief Return the counters of the harness, opened on first use
+ */
+inline perf_counters& get_perf_counters(){
+    static perf_counters counters;
+    return counters;
+}
+
+} //end of namespace evb
@@ -0,0 +1,153 @@
+#pragma once
+
+// Machine probes for the roofline: a STREAM-like triad for the memory
+// bandwidth and a register-only FMA kernel for the peak floating-point
+// throughput. Both are run with the given number of threads, the best of
+// several repetitions is kept.
+
+#include <cstddef>
+#include <cstdio>
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace evb {
+
+/*!
+ * \brief The roof of the machine for a given number of threads
+ */
+struct roof {
+    double bandwidth;   ///< Memory bandwidth, in bytes per second
+    double peak_double; ///< Peak double-precision throughput, in FLOP per second
+    double peak_single; ///< Peak single-precision throughput, in FLOP per second
+};
+
+namespace detail {
+
+/*!
+ * \brief Run the given functor on n threads, each getting its index, and return the elapsed seconds
+ */
+template <typename Functor>
+double run_threads(std::size_t n, Functor functor){
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+
+    for(std::size_t t = 0; t < n; ++t){
+        threads.emplace_back(functor, t);
+    }
+
+    for(auto& thread : threads){
+        thread.join();
+    }
+
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+inline double probe_bandwidth(std::size_t n){
+    // 64MiB per array, well beyond the last-level caches
+    constexpr std::size_t size = 1UL << 23;
+
+    std::unique_ptr<double[]> a(new double[size]);
+    std::unique_ptr<double[]> b(new double[size]);
+    std::unique_ptr<double[]> c(new double[size]);
+
+    // First touch from the threads that will use the memory
+    run_threads(n, [&](std::size_t t){
+        for(std::size_t i = t * size / n; i < (t + 1) * size / n; ++i){
+            a[i] = 0.0;
+            b[i] = 1.0;
+            c[i] = 2.0;
+        }
+    });
+
+    double best = 1e9;
+
+    for(std::size_t r = 0; r < 10; ++r){
+        best = std::min(best, run_threads(n, [&](std::size_t t){
+            double* __restrict ra = a.get();
+            const double* __restrict rb = b.get();
+            const double* __restrict rc = c.get();
+
+            for(std::size_t i = t * size / n; i < (t + 1) * size / n; ++i){
+                ra[i] = rb[i] + 3.0 * rc[i];
+            }
+        }));
+    }
+
+    if(a[size / 2] != 7.0){
+        std::fprintf(stderr, "[evb] invalid result of the bandwidth probe\n");
+    }
+
+    return 3 * sizeof(double) * size / best;
+}
+
+template <typename T>
+double probe_peak(std::size_t n){
+    // Enough independent accumulators to cover the latency of the FMA units
+    constexpr std::size_t accumulators = 128 / sizeof(T) * 4;
+    constexpr std::size_t iterations   = 1UL << 22;
+
+    std::vector<T> sink(n);
+
+    double best = 1e9;
+
+    for(std::size_t r = 0; r < 5; ++r){
+        best = std::min(best, run_threads(n, [&](std::size_t t){
+            T acc[accumulators];
+
+            for(std::size_t j = 0; j < accumulators; ++j){
+                acc[j] = T(j);
+            }
+
+            const T x = T(0.999999);
+            const T y = T(1e-6);
+
+            for(std::size_t i = 0; i < iterations; ++i){
+                for(std::size_t j = 0; j < accumulators; ++j){
+                    acc[j] = acc[j] * x + y;
+                }
+            }
+
+            T sum = 0;
+
+            for(std::size_t j = 0; j < accumulators; ++j){
+                sum += acc[j];
+            }
+
+            sink[t] = sum;
+        }));
+    }
+
+    return 2.0 * accumulators * iterations * n / best;
+}
+
+} //end of namespace detail
+
+/*!
+ * \brief Return the roof of the machine for the given number of threads, probed on first use
+ */
+inline const roof& get_roof(std::size_t threads){
+    static std::map<std::size_t, roof> roofs;
+
+    auto it = roofs.find(threads);
+
+    if(it == roofs.end()){
+        roof r;
+        r.bandwidth   = detail::probe_bandwidth(threads);
+        r.peak_double = detail::probe_peak<double>(threads);
+        r.peak_single = detail::probe_peak<float>(threads);
+
+        std::printf("[evb] roofline with %zu thread(s): %.2f GB/s, %.2f GFLOP/s (d), %.2f GFLOP/s (s)\n",
+                    threads, r.bandwidth / 1e9, r.peak_double / 1e9, r.peak_single / 1e9);
+
+        it = roofs.emplace(threads, r).first;
+    }
+
+    return it->second;
+}
+
+} //end of namespace evb
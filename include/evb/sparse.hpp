@@ -0,0 +1,250 @@
+#pragma once
+
+// Deterministic generators of sparse matrices, as sorted coordinate lists,
+// and a loader for Matrix Market files. The libraries build their own
+// compressed formats from these triplets.
+
+#include <cstddef>
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace evb {
+
+/*!
+ * \brief A sparse matrix in coordinate format, sorted by row then column
+ */
+struct triplets {
+    std::size_t rows = 0;
+    std::size_t cols = 0;
+    std::vector<std::size_t> row;
+    std::vector<std::size_t> col;
+    std::vector<double> value;
+
+    std::size_t nnz() const {
+        return value.size();
+    }
+
+    void add(std::size_t i, std::size_t j, double v){
+        row.push_back(i);
+        col.push_back(j);
+        value.push_back(v);
+    }
+
+    /*!
+     * \brief Sort the entries by row then column and merge the duplicates
+     */
+    void sort(){
+        std::vector<std::size_t> order(nnz());
+
+        for(std::size_t k = 0; k < order.size(); ++k){
+            order[k] = k;
+        }
+
+        std::sort(order.begin(), order.end(), [this](std::size_t a, std::size_t b){
+            return std::tie(row[a], col[a]) < std::tie(row[b], col[b]);
+        });
+
+        triplets sorted;
+        sorted.rows = rows;
+        sorted.cols = cols;
+
+        for(auto k : order){
+            if(sorted.nnz() && sorted.row.back() == row[k] && sorted.col.back() == col[k]){
+                sorted.value.back() += value[k];
+            } else {
+                sorted.add(row[k], col[k], value[k]);
+            }
+        }
+
+        *this = std::move(sorted);
+    }
+};
+
+/*!
+ * \brief Generate a n x n banded matrix with the given number of diagonals on each side
+ */
+inline triplets banded(std::size_t n, std::size_t band){
+    triplets t;
+    t.rows = n;
+    t.cols = n;
+
+    for(std::size_t i = 0; i < n; ++i){
+        for(std::size_t j = i > band ? i - band : 0; j < std::min(n, i + band + 1); ++j){
+            t.add(i, j, i == j ? 2.0 * band + 1 : -1.0 / (1.0 + (i > j ? i - j : j - i)));
+        }
+    }
+
+    return t;
+}
+
+/*!
+ * \brief Generate the 5-point stencil of the 2D Poisson equation on a k x k grid
+ */
+inline triplets poisson_2d(std::size_t k){
+    triplets t;
+    t.rows = k * k;
+    t.cols = k * k;
+
+    for(std::size_t x = 0; x < k; ++x){
+        for(std::size_t y = 0; y < k; ++y){
+            std::size_t i = x * k + y;
+
+            if(x > 0){
+                t.add(i, i - k, -1.0);
+            }
+
+            if(y > 0){
+                t.add(i, i - 1, -1.0);
+            }
+
+            t.add(i, i, 4.0);
+
+            if(y + 1 < k){
+                t.add(i, i + 1, -1.0);
+            }
+
+            if(x + 1 < k){
+                t.add(i, i + k, -1.0);
+            }
+        }
+    }
+
+    return t;
+}
+
+/*!
+ * \brief Generate a 2^scale x 2^scale matrix with a power-law distribution of
+ * the non-zeros per row and column, with the R-MAT recursive model.
+ */
+inline triplets power_law(std::size_t scale, std::size_t edge_factor = 16){
+    const std::size_t n = std::size_t(1) << scale;
+
+    triplets t;
+    t.rows = n;
+    t.cols = n;
+
+    std::mt19937_64 generator(scale);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+
+    // The probabilities of the four quadrants (a, b, c, d = 1 - a - b - c)
+    const double a = 0.57;
+    const double b = 0.19;
+    const double c = 0.19;
+
+    for(std::size_t e = 0; e < edge_factor * n; ++e){
+        std::size_t i = 0;
+        std::size_t j = 0;
+
+        for(std::size_t bit = n >> 1; bit; bit >>= 1){
+            double p = dist(generator);
+
+            if(p >= a + b + c){
+                i |= bit;
+                j |= bit;
+            } else if(p >= a + b){
+                i |= bit;
+            } else if(p >= a){
+                j |= bit;
+            }
+        }
+
+        t.add(i, j, dist(generator));
+    }
+
+    t.sort();
+
+    return t;
+}
+
+/*!
+ * \brief Load a coordinate Matrix Market file (real, integer or pattern, general or symmetric)
+ */
+inline triplets load_matrix_market(const std::string& path){
+    std::ifstream stream(path);
+
+    if(!stream){
+        throw std::runtime_error("Cannot open " + path);
+    }
+
+    std::string line;
+    std::getline(stream, line);
+
+    std::string banner, object, format, field, symmetry;
+    std::istringstream(line) >> banner >> object >> format >> field >> symmetry;
+
+    if(banner != "%%MatrixMarket" || object != "matrix" || format != "coordinate" || field == "complex"){
+        throw std::runtime_error(path + " is not a real coordinate Matrix Market file");
+    }
+
+    bool pattern   = field == "pattern";
+    bool symmetric = symmetry == "symmetric" || symmetry == "skew-symmetric";
+    double mirror  = symmetry == "skew-symmetric" ? -1.0 : 1.0;
+
+    while(std::getline(stream, line) && line[0] == '%'){}
+
+    triplets t;
+    std::size_t entries = 0;
+
+    if(!(std::istringstream(line) >> t.rows >> t.cols >> entries)){
+        throw std::runtime_error(path + ": invalid size line");
+    }
+
+    std::size_t e = 0;
+
+    for(; e < entries && std::getline(stream, line); ++e){
+        std::size_t i = 0;
+        std::size_t j = 0;
+        double v      = 1.0;
+
+        std::istringstream entry(line);
+        entry >> i >> j;
+
+        if(!pattern){
+            entry >> v;
+        }
+
+        if(!entry || i == 0 || j == 0 || i > t.rows || j > t.cols){
+            throw std::runtime_error(path + ": invalid entry \"" + line + "\"");
+        }
+
+        // Matrix Market indices start at 1
+        t.add(i - 1, j - 1, v);
+
+        if(symmetric && i != j){
+            t.add(j - 1, i - 1, mirror * v);
+        }
+    }
+
+    if(e < entries){
+        throw std::runtime_error(path + " is truncated: " + std::to_string(e) + " of " + std::to_string(entries) + " entries");
+    }
+
+    t.sort();
+
+    return t;
+}
+
+/*!
+ * \brief Return the generated matrix for the given key, generating it on first use
+ */
+template <typename Generator>
+const triplets& memoize(const std::string& key, Generator generator){
+    static std::map<std::string, triplets> cache;
+
+    auto it = cache.find(key);
+
+    if(it == cache.end()){
+        it = cache.emplace(key, generator()).first;
+    }
+
+    return it->second;
+}
+
+} //end of namespace evb
@@ -0,0 +1,76 @@
+#pragma once
+
+// Control of the number of threads used by each library and by the BLAS
+// backend. ETL uses its own thread pool, sized once (etl::threads), so for
+// ETL the count only selects between serial and parallel execution. The
+// threads are also pinned to the CPUs of EVB_CPUS, see numa.hpp.
+
+#include <cstddef>
+#include <string>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifdef ETL_MKL_MODE
+#include <mkl_service.h>
+#endif
+
+#ifdef EVB_OPENBLAS
+extern "C" void openblas_set_num_threads(int n);
+#endif
+
+#ifdef EVB_BLIS
+extern "C" void bli_thread_set_num_threads(long n);
+#endif
+
+#include <eigen3/Eigen/Core>
+#include "etl/etl.hpp"
+#include <blaze/Math.h>
+
+#include "evb/numa.hpp"
+
+namespace evb {
+
+/*!
+ * \brief Return the number of threads the given library really uses when n
+ * threads are requested. ETL runs either serially or on its whole pool.
+ */
+inline std::size_t library_threads(const std::string& library, std::size_t n){
+    if(library.compare(0, 3, "etl") == 0){
+        return n == 1 ? 1 : etl::threads;
+    }
+
+    return n;
+}
+
+/*!
+ * \brief Set the number of threads used by all the libraries and by the BLAS backend
+ */
+inline void set_threads(std::size_t n){
+#ifdef _OPENMP
+    omp_set_num_threads(n);
+#endif
+
+#ifdef ETL_MKL_MODE
+    mkl_set_num_threads(n);
+#endif
+
+#ifdef EVB_OPENBLAS
+    openblas_set_num_threads(n);
+#endif
+
+#ifdef EVB_BLIS
+    bli_thread_set_num_threads(n);
+#endif
+
+    blaze::setNumThreads(n);
+    Eigen::setNbThreads(n);
+
+    etl::local_context().serial   = n == 1;
+    etl::local_context().parallel = n > 1;
+
+    pin_threads(n);
+}
+
+} //end of namespace evb
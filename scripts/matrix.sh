@@ -0,0 +1,68 @@
+#!/bin/bash
+
+# Build and run the benchmark with several BLAS backends and instruction sets,
+# then merge their results into a single table.
+#
+#   ./scripts/matrix.sh [arguments of bench]
+#
+# BACKENDS (default "mkl openblas blis none") are built for the native
+# instruction set, ISAS (default "sse4 avx2 avx512") are built without BLAS,
+# so that only the kernels of the libraries change. The binaries, their
+# output and the CSV results are stored in OUT (default "results").
+
+set -u
+
+cd "$(dirname "$0")/.."
+
+BACKENDS=${BACKENDS:-mkl openblas blis none}
+ISAS=${ISAS:-sse4 avx2 avx512}
+OUT=${OUT:-results}
+
+mkdir -p "$OUT/bin"
+rm -f "$OUT"/bin/bench-* "$OUT"/*.csv
+
+builds=()
+
+for blas in $BACKENDS; do
+    builds+=("$blas native")
+done
+
+for isa in $ISAS; do
+    builds+=("none $isa")
+done
+
+for build in "${builds[@]}"; do
+    read -r blas isa <<< "$build"
+    name="$blas-$isa"
+
+    echo "[matrix] building $name"
+
+    # The objects do not depend on the flags, everything is rebuilt
+    if make clean > /dev/null && make -j"$(nproc)" BLAS="$blas" ISA="$isa" release > "$OUT/$name.log" 2>&1; then
+        cp release/bin/bench "$OUT/bin/bench-$name"
+    else
+        echo "[matrix] cannot build $name, see $OUT/$name.log"
+    fi
+done
+
+for bin in "$OUT"/bin/bench-*; do
+    [ -e "$bin" ] || continue
+
+    name=${bin##*/bench-}
+
+    echo "[matrix] running $name"
+
+    # An instruction set not supported by the machine stops the binary with SIGILL
+    if ! EVB_CSV="$OUT/$name.csv" "$bin" "$@" > "$OUT/$name.txt" 2>&1; then
+        echo "[matrix] $name failed, see $OUT/$name.txt"
+    fi
+done
+
+csv=("$OUT"/*.csv)
+
+if [ -e "${csv[0]}" ]; then
+    python3 scripts/merge.py "${csv[@]}" | tee "$OUT/matrix.txt"
+else
+    echo "[matrix] no results"
+    exit 1
+fi
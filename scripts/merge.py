@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+
+"""
+Merge the CSV results (EVB_CSV) of several builds or runs into a single
+comparison table, with one column per build.
+
+    ./scripts/merge.py results/*.csv [--metric time_ns] [--baseline mkl-native] [--csv merged.csv]
+
+For each section, the rows are the library, thread count and size of each
+point, and each build gets a column with the selected metric. When a
+baseline is given (the first build by default), the ratio of each build to
+the baseline is given next to its value.
+"""
+
+import argparse
+import csv
+import sys
+from collections import OrderedDict
+
+
+def read(paths):
+    builds = []
+    values = OrderedDict()
+
+    for path in paths:
+        with open(path, newline="") as stream:
+            for line in csv.DictReader(stream):
+                if line["build"] not in builds:
+                    builds.append(line["build"])
+
+                key = (line["section"], line["library"], int(line["threads"]), line["size"])
+                values.setdefault(key, {}).setdefault(line["build"], {})[line["metric"]] = line["value"]
+
+    return builds, values
+
+
+def number(value):
+    try:
+        return float(value)
+    except (TypeError, ValueError):
+        return None
+
+
+def print_table(rows):
+    widths = [max(len(row[c]) for row in rows) for c in range(len(rows[0]))]
+
+    for row in rows:
+        print(" " + " ".join(cell.ljust(widths[c]) if c < 3 else cell.rjust(widths[c]) for c, cell in enumerate(row)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Merge the CSV results of several builds")
+    parser.add_argument("files", nargs="+", help="CSV files written with EVB_CSV")
+    parser.add_argument("--metric", default="time_ns", help="The metric to compare (default: time_ns)")
+    parser.add_argument("--baseline", help="The build to compare to (default: the first one)")
+    parser.add_argument("--csv", help="Also write the merged table to this CSV file")
+    args = parser.parse_args()
+
+    builds, values = read(args.files)
+
+    if not builds:
+        sys.exit("No results")
+
+    baseline = args.baseline or builds[0]
+
+    if baseline not in builds:
+        sys.exit("Unknown baseline " + baseline + ", the builds are " + ", ".join(builds))
+
+    sections = OrderedDict()
+
+    for key, by_build in values.items():
+        sections.setdefault(key[0], []).append((key, by_build))
+
+    header = ["library", "threads", "size"]
+
+    for build in builds:
+        header.append(build)
+
+        if build != baseline:
+            header.append("/" + baseline)
+
+    merged = []
+
+    for section, points in sections.items():
+        rows = [header]
+
+        for key, by_build in points:
+            row = [key[1], str(key[2]), key[3]]
+            base = number(by_build.get(baseline, {}).get(args.metric))
+
+            for build in builds:
+                value = by_build.get(build, {}).get(args.metric)
+                row.append(value if value is not None else "-")
+
+                if build != baseline:
+                    v = number(value)
+                    row.append("%.2f" % (v / base) if v is not None and base else "-")
+
+            rows.append(row)
+            merged.append([section] + row)
+
+        print("\n[matrix] %s (%s)" % (section, args.metric))
+        print_table(rows)
+
+    if args.csv:
+        with open(args.csv, "w", newline="") as stream:
+            writer = csv.writer(stream)
+            writer.writerow(["section"] + header)
+            writer.writerows(merged)
+
+
+if __name__ == "__main__":
+    main()
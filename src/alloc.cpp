@@ -0,0 +1,150 @@
+#include "evb/alloc.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+// The allocation functions of glibc are replaced by functions counting the
+// allocations when tracking is active and forwarding to the __libc_*
+// implementations. Memory is accounted with malloc_usable_size so that free()
+// does not need to know the requested size.
+//
+// The live bytes are not reset between the tracking windows, the peak of a
+// window is taken relative to the live bytes at its start. A window can free
+// memory allocated before it, the live bytes can then fall below the
+// baseline, which is why the peak is clamped at zero.
+
+namespace {
+
+std::atomic<bool> active(false);
+std::atomic<std::size_t> allocs(0);
+std::atomic<std::size_t> bytes(0);
+std::atomic<long long> live(0);
+std::atomic<long long> peak(0);
+long long baseline = 0;
+
+} //end of anonymous namespace
+
+#ifdef __GLIBC__
+
+#include <cerrno>
+#include <malloc.h>
+
+extern "C" {
+
+void* __libc_malloc(std::size_t size);
+void* __libc_calloc(std::size_t n, std::size_t size);
+void* __libc_realloc(void* ptr, std::size_t size);
+void* __libc_memalign(std::size_t alignment, std::size_t size);
+void __libc_free(void* ptr);
+
+} //end of extern "C"
+
+namespace {
+
+void track_alloc(void* ptr){
+    if(ptr && active.load(std::memory_order_relaxed)){
+        long long size = malloc_usable_size(ptr);
+
+        allocs.fetch_add(1, std::memory_order_relaxed);
+        bytes.fetch_add(size, std::memory_order_relaxed);
+
+        long long current = live.fetch_add(size, std::memory_order_relaxed) + size;
+        long long previous = peak.load(std::memory_order_relaxed);
+
+        while(current > previous && !peak.compare_exchange_weak(previous, current, std::memory_order_relaxed)){}
+    }
+}
+
+void track_free(void* ptr){
+    if(ptr && active.load(std::memory_order_relaxed)){
+        live.fetch_sub(malloc_usable_size(ptr), std::memory_order_relaxed);
+    }
+}
+
+} //end of anonymous namespace
+
+extern "C" {
+
+void* malloc(std::size_t size){
+    void* ptr = __libc_malloc(size);
+    track_alloc(ptr);
+    return ptr;
+}
+
+void* calloc(std::size_t n, std::size_t size){
+    void* ptr = __libc_calloc(n, size);
+    track_alloc(ptr);
+    return ptr;
+}
+
+void* realloc(void* ptr, std::size_t size){
+    track_free(ptr);
+    void* new_ptr = __libc_realloc(ptr, size);
+    track_alloc(new_ptr);
+    return new_ptr;
+}
+
+void* memalign(std::size_t alignment, std::size_t size){
+    void* ptr = __libc_memalign(alignment, size);
+    track_alloc(ptr);
+    return ptr;
+}
+
+void* aligned_alloc(std::size_t alignment, std::size_t size){
+    return memalign(alignment, size);
+}
+
+int posix_memalign(void** result, std::size_t alignment, std::size_t size){
+    if(!alignment || (alignment & (alignment - 1)) || alignment % sizeof(void*)){
+        return EINVAL;
+    }
+
+    void* ptr = memalign(alignment, size);
+
+    if(!ptr){
+        return ENOMEM;
+    }
+
+    *result = ptr;
+
+    return 0;
+}
+
+void free(void* ptr){
+    track_free(ptr);
+    __libc_free(ptr);
+}
+
+} //end of extern "C"
+
+#endif
+
+namespace evb {
+
+bool alloc_available(){
+#ifdef __GLIBC__
+    return true;
+#else
+    return false;
+#endif
+}
+
+void alloc_start(){
+    allocs = 0;
+    bytes  = 0;
+    baseline = live;
+    peak     = baseline;
+    active   = true;
+}
+
+alloc_stats alloc_stop(){
+    active = false;
+
+    alloc_stats stats;
+    stats.allocs = allocs;
+    stats.bytes  = bytes;
+    stats.peak   = std::max(peak - baseline, 0LL);
+    return stats;
+}
+
+} //end of namespace evb
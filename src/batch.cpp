@@ -0,0 +1,192 @@
+#define CPM_LIB
+#include "benchmark.hpp"
+
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+
+// Batches of independent small matrix products, C[i] = A[i] * B[i]. At these
+// sizes, the cost of dispatching each product matters more than the speed of
+// the GEMM kernel. The loops over the batch are parallelized with OpenMP, so
+// they follow the thread count of the harness (EVB_THREADS).
+
+namespace {
+
+using etl_dbatch = etl::dyn_matrix<double, 3>;
+
+// Run f(i) for each matrix of the batch
+template<typename F>
+void parallel_batch(long batch, F f){
+#pragma omp parallel for
+    for(long i = 0; i < batch; ++i){
+        f(i);
+    }
+}
+
+// A batch of static Blaze matrices, the size being selected at runtime. The
+// harness reaches the values of A, B and C through functors built with them.
+struct blaze_static_batch {
+    using visitor = std::function<void(double&)>;
+
+    // One operand of the batch, whose type depends on the size
+    struct operand {
+        std::function<std::size_t(const visitor&)> visit;
+
+        template<typename F>
+        std::size_t for_each_value(F&& f){
+            return visit(visitor(f));
+        }
+    };
+
+    std::function<void()> multiply;
+    operand A, B, C;
+
+    auto operands(){
+        return std::tie(A, B, C);
+    }
+};
+
+template<std::size_t N>
+blaze_static_batch make_blaze_static_batch(std::size_t batch){
+    using mat = blaze_static_matrix<double, N, N>;
+    using vec = std::vector<mat, blaze::AlignedAllocator<mat>>;
+
+    auto A = std::make_shared<vec>(batch, mat(0.0));
+    auto B = std::make_shared<vec>(batch, mat(0.0));
+    auto C = std::make_shared<vec>(batch, mat(0.0));
+
+    auto visit = [](std::shared_ptr<vec> m){
+        return [m](const blaze_static_batch::visitor& f){ return evb::for_each_value(*m, f); };
+    };
+
+    return {[A, B, C](){
+        parallel_batch(A->size(), [&](long i){ (*C)[i] = (*A)[i] * (*B)[i]; });
+    }, {visit(A)}, {visit(B)}, {visit(C)}};
+}
+
+blaze_static_batch make_blaze_static_batch(std::size_t batch, std::size_t n){
+    switch(n){
+        case 8:
+            return make_blaze_static_batch<8>(batch);
+        case 16:
+            return make_blaze_static_batch<16>(batch);
+        case 32:
+            return make_blaze_static_batch<32>(batch);
+        case 64:
+            return make_blaze_static_batch<64>(batch);
+        default:
+            throw std::invalid_argument("No static Blaze batch of size " + std::to_string(n));
+    }
+}
+
+// Contiguous buffers of matrices, with one pointer per matrix, for Eigen and BLAS
+struct raw_batch {
+    std::size_t batch;
+    std::size_t n;
+    std::vector<double> A;
+    std::vector<double> B;
+    std::vector<double> C;
+    std::vector<const double*> A_ptr;
+    std::vector<const double*> B_ptr;
+    std::vector<double*> C_ptr;
+
+    raw_batch(std::size_t batch, std::size_t n) : batch(batch), n(n), A(batch * n * n), B(batch * n * n), C(batch * n * n), A_ptr(batch), B_ptr(batch), C_ptr(batch) {
+        update();
+    }
+
+    // The buffers, filled and validated like the operands of the other libraries
+    auto operands(){
+        return std::tie(A, B, C);
+    }
+
+    // Point to the buffers, which may have moved since the batch was created
+    void update(){
+        if(C_ptr[0] != C.data()){
+            for(std::size_t i = 0; i < batch; ++i){
+                A_ptr[i] = A.data() + i * n * n;
+                B_ptr[i] = B.data() + i * n * n;
+                C_ptr[i] = C.data() + i * n * n;
+            }
+        }
+    }
+};
+
+// Pairs of (batch size, matrix size)
+using batch_policy = NARY_POLICY(
+    VALUES_POLICY(100, 1000, 10000, 100, 1000, 10000, 100, 1000, 10000, 100, 1000, 2000),
+    VALUES_POLICY(8, 8, 8, 16, 16, 16, 32, 32, 32, 64, 64, 64));
+
+EVB_SECTION_P("C[i] = A[i] * B[i]", batch_policy)
+    EVB_COST(double,
+        [](std::size_t b, std::size_t n){ return 2.0 * b * n * n * n; },
+        [](std::size_t b, std::size_t n){ return 3.0 * 8 * b * n * n; });
+
+    EVB_ITEMS("matrices", [](std::size_t b, std::size_t){ return 1.0 * b; });
+
+    EVB_TWO_PASS_NS("etl",
+        [](std::size_t b, std::size_t n){ return std::make_tuple(etl_dbatch(b, n, n), etl_dbatch(b, n, n), etl_dbatch(b, n, n)); },
+        [](etl_dbatch& A, etl_dbatch& B, etl_dbatch& C){
+            parallel_batch(etl::dim<0>(A), [&](long i){ C(i) = A(i) * B(i); });
+        });
+
+    EVB_TWO_PASS_NS("blaze-dyn",
+        [](std::size_t b, std::size_t n){ return std::make_tuple(std::vector<blaze_dmat>(b, blaze_dmat(n, n, 0.0)), std::vector<blaze_dmat>(b, blaze_dmat(n, n, 0.0)), std::vector<blaze_dmat>(b, blaze_dmat(n, n, 0.0))); },
+        [](std::vector<blaze_dmat>& A, std::vector<blaze_dmat>& B, std::vector<blaze_dmat>& C){
+            parallel_batch(A.size(), [&](long i){ C[i] = A[i] * B[i]; });
+        });
+
+    EVB_TWO_PASS_NS("blaze-static",
+        [](std::size_t b, std::size_t n){ return std::make_tuple(make_blaze_static_batch(b, n)); },
+        [](blaze_static_batch& batch){ batch.multiply(); });
+
+    // The raw buffers are in row-major order, like the ETL and BLAS batches
+    EVB_TWO_PASS_NS("eigen-map",
+        [](std::size_t b, std::size_t n){ return std::make_tuple(raw_batch(b, n)); },
+        [](raw_batch& r){
+            const long n = r.n;
+
+            r.update();
+
+            parallel_batch(r.batch, [&](long i){
+                Eigen::Map<const eigen_dmat_rm> A(r.A_ptr[i], n, n);
+                Eigen::Map<const eigen_dmat_rm> B(r.B_ptr[i], n, n);
+                Eigen::Map<eigen_dmat_rm> C(r.C_ptr[i], n, n);
+
+                C.noalias() = A * B;
+            });
+        });
+
+#ifdef EVB_BLAS
+    EVB_TWO_PASS_NS("blas-loop",
+        [](std::size_t b, std::size_t n){ return std::make_tuple(raw_batch(b, n)); },
+        [](raw_batch& r){
+            const int n = r.n;
+
+            r.update();
+
+            parallel_batch(r.batch, [&](long i){
+                cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, n, n, n, 1.0, r.A_ptr[i], n, r.B_ptr[i], n, 0.0, r.C_ptr[i], n);
+            });
+        });
+#endif
+
+#ifdef ETL_MKL_MODE
+    // A single group of identical products, MKL handles the threading
+    EVB_TWO_PASS_NS("mkl-batch",
+        [](std::size_t b, std::size_t n){ return std::make_tuple(raw_batch(b, n)); },
+        [](raw_batch& r){
+            r.update();
+
+            const CBLAS_TRANSPOSE trans = CblasNoTrans;
+            const MKL_INT n             = r.n;
+            const MKL_INT size          = r.batch;
+            const double alpha          = 1.0;
+            const double beta           = 0.0;
+
+            cblas_dgemm_batch(CblasRowMajor, &trans, &trans, &n, &n, &n, &alpha, r.A_ptr.data(), &n, r.B_ptr.data(), &n, &beta, r.C_ptr.data(), &n, 1, &size);
+        });
+#endif
+}
+
+} //end of anonymous namespace
@@ -0,0 +1,115 @@
+#define CPM_LIB
+#include "benchmark.hpp"
+
+#include <cmath>
+
+// Kernels measured at working sets relative to the caches of the machine
+// rather than at fixed sizes, see evb/cache.hpp. The size reported by CPM is
+// the index of the regime, the harness report gives the regime, the real
+// working set and the level that holds it. Run with EVB_COLD=1 to start each
+// call with cold caches.
+
+namespace {
+
+// The regimes, from a quarter of L1 to 8 times the last level of cache
+using cache_policy = VALUES_POLICY(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11);
+
+// The number of elements of each vector for the given regime
+std::size_t regime_vector(std::size_t r, std::size_t bytes_per_element){
+    return std::max<std::size_t>(1, evb::regime_bytes(r) / bytes_per_element);
+}
+
+// The dimension of a square matrix of doubles for the given regime
+std::size_t regime_matrix(std::size_t r){
+    return std::max<std::size_t>(1, static_cast<std::size_t>(std::sqrt(evb::regime_bytes(r) / 8.0)));
+}
+
+EVB_SECTION_P("r = a + b (cache)", cache_policy)
+    EVB_COST(double,
+        [](std::size_t r){ return 1.0 * regime_vector(r, 24); },
+        [](std::size_t r){ return 3.0 * 8 * regime_vector(r, 24); });
+
+    EVB_TWO_PASS_NS("etl",
+        [](std::size_t r){ evb::tag("regime", evb::regime_name(r)); auto d = regime_vector(r, 24); return std::make_tuple(etl_dvec(d), etl_dvec(d), etl_dvec(d)); },
+        [](etl_dvec& r, etl_dvec& a, etl_dvec& b){ r = a + b; }
+        );
+
+    EVB_TWO_PASS_NS("blaze",
+        [](std::size_t r){ evb::tag("regime", evb::regime_name(r)); auto d = regime_vector(r, 24); return std::make_tuple(blaze_dvec(d), blaze_dvec(d), blaze_dvec(d)); },
+        [](blaze_dvec& r, blaze_dvec& a, blaze_dvec& b){ r = a + b; }
+        );
+
+    EVB_TWO_PASS_NS("eigen",
+        [](std::size_t r){ evb::tag("regime", evb::regime_name(r)); auto d = regime_vector(r, 24); return std::make_tuple(eigen_dvec(d), eigen_dvec(d), eigen_dvec(d)); },
+        [](eigen_dvec& r, eigen_dvec& a, eigen_dvec& b){ r = a + b; }
+        );
+}
+
+EVB_SECTION_P("r *= 3.3 (cache)", cache_policy)
+    EVB_COST(double,
+        [](std::size_t r){ return 1.0 * regime_vector(r, 8); },
+        [](std::size_t r){ return 2.0 * 8 * regime_vector(r, 8); });
+
+    // r is kept at zero, scaled in place with the data of EVB_DATA it would overflow to inf
+    EVB_OWN_DATA();
+
+    EVB_TWO_PASS_NS("etl",
+        [](std::size_t r){ evb::tag("regime", evb::regime_name(r)); return std::make_tuple(etl_dvec(regime_vector(r, 8), 0.0)); },
+        [](etl_dvec& r){ r *= 3.3; }
+        );
+
+    EVB_TWO_PASS_NS("blaze",
+        [](std::size_t r){ evb::tag("regime", evb::regime_name(r)); return std::make_tuple(blaze_dvec(regime_vector(r, 8), 0.0)); },
+        [](blaze_dvec& r){ r *= 3.3; }
+        );
+
+    EVB_TWO_PASS_NS("eigen",
+        [](std::size_t r){ evb::tag("regime", evb::regime_name(r)); return std::make_tuple(eigen_dvec(eigen_dvec::Zero(regime_vector(r, 8)))); },
+        [](eigen_dvec& r){ r *= 3.3; }
+        );
+}
+
+EVB_SECTION_P("dot (cache)", cache_policy)
+    EVB_COST(double,
+        [](std::size_t r){ return 2.0 * regime_vector(r, 16); },
+        [](std::size_t r){ return 2.0 * 8 * regime_vector(r, 16); });
+
+    // The result is accumulated in a vector of one element so that the dot product is not optimized away
+    EVB_TWO_PASS_NS("etl",
+        [](std::size_t r){ evb::tag("regime", evb::regime_name(r)); auto d = regime_vector(r, 16); return std::make_tuple(etl_dvec(d), etl_dvec(d), etl_dvec(1)); },
+        [](etl_dvec& a, etl_dvec& b, etl_dvec& c){ c[0] += etl::dot(a, b); }
+        );
+
+    EVB_TWO_PASS_NS("blaze",
+        [](std::size_t r){ evb::tag("regime", evb::regime_name(r)); auto d = regime_vector(r, 16); return std::make_tuple(blaze_dvec(d), blaze_dvec(d), blaze_dvec(1)); },
+        [](blaze_dvec& a, blaze_dvec& b, blaze_dvec& c){ c[0] += (a, b); }
+        );
+
+    EVB_TWO_PASS_NS("eigen",
+        [](std::size_t r){ evb::tag("regime", evb::regime_name(r)); auto d = regime_vector(r, 16); return std::make_tuple(eigen_dvec(d), eigen_dvec(d), eigen_dvec(1)); },
+        [](eigen_dvec& a, eigen_dvec& b, eigen_dvec& c){ c[0] += a.dot(b); }
+        );
+}
+
+EVB_SECTION_P("r = A * b (cache)", cache_policy)
+    EVB_COST(double,
+        [](std::size_t r){ auto d = regime_matrix(r); return 2.0 * d * d; },
+        [](std::size_t r){ auto d = regime_matrix(r); return 8.0 * (d * d + 2 * d); });
+
+    EVB_TWO_PASS_NS("etl",
+        [](std::size_t r){ evb::tag("regime", evb::regime_name(r)); auto d = regime_matrix(r); return std::make_tuple(etl_dmat(d, d), etl_dvec(d), etl_dvec(d)); },
+        [](etl_dmat& A, etl_dvec& b, etl_dvec& r){ r = A * b; }
+        );
+
+    EVB_TWO_PASS_NS("blaze",
+        [](std::size_t r){ evb::tag("regime", evb::regime_name(r)); auto d = regime_matrix(r); return std::make_tuple(blaze_dmat(d, d), blaze_dvec(d), blaze_dvec(d)); },
+        [](blaze_dmat& A, blaze_dvec& b, blaze_dvec& r){ r = A * b; }
+        );
+
+    EVB_TWO_PASS_NS("eigen",
+        [](std::size_t r){ evb::tag("regime", evb::regime_name(r)); auto d = regime_matrix(r); return std::make_tuple(eigen_dmat(d, d), eigen_dvec(d), eigen_dvec(d)); },
+        [](eigen_dmat& A, eigen_dvec& b, eigen_dvec& r){ r = A * b; }
+        );
+}
+
+} //end of anonymous namespace
@@ -0,0 +1,437 @@
+#define CPM_LIB
+#include "benchmark.hpp"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <eigen3/unsupported/Eigen/CXX11/Tensor>
+
+// Convolution and pooling kernels of convolutional networks, in single
+// precision. ETL is measured with its default kernels and with each of its
+// implementations (direct, vectorized direct and FFT for full convolutions).
+// Eigen is measured with the convolve of its Tensor module and the batched
+// convolutions with an im2col + GEMM baseline built on Blaze. The convolve
+// of Eigen is a correlation, so the kernel is reversed to compute the same
+// (flipped-kernel) convolutions as ETL.
+
+namespace {
+
+using etl_smat4 = etl::dyn_matrix<float, 4>;
+
+using eigen_stensor1 = Eigen::Tensor<float, 1, Eigen::RowMajor>;
+using eigen_stensor2 = Eigen::Tensor<float, 2, Eigen::RowMajor>;
+using eigen_stensor4 = Eigen::Tensor<float, 4, Eigen::RowMajor>;
+
+template<typename T, typename... D>
+T zero_tensor(D... dims){
+    T t(static_cast<Eigen::Index>(dims)...);
+    t.setZero();
+    return t;
+}
+
+// Eigen only has valid convolutions, the input is padded for the full and same convolutions
+void eigen_conv_1d(eigen_stensor1& r, const eigen_stensor1& a, const eigen_stensor1& b, Eigen::Index pad){
+    Eigen::array<Eigen::Index, 1> dims{{0}};
+    Eigen::array<bool, 1> reverse{{true}};
+
+    if(pad){
+        Eigen::array<std::pair<Eigen::Index, Eigen::Index>, 1> padding{{std::make_pair(pad, pad)}};
+        r = a.pad(padding).convolve(b.reverse(reverse), dims);
+    } else {
+        r = a.convolve(b.reverse(reverse), dims);
+    }
+}
+
+void eigen_conv_2d(eigen_stensor2& r, const eigen_stensor2& a, const eigen_stensor2& b, Eigen::Index pad){
+    Eigen::array<Eigen::Index, 2> dims{{0, 1}};
+    Eigen::array<bool, 2> reverse{{true, true}};
+
+    if(pad){
+        Eigen::array<std::pair<Eigen::Index, Eigen::Index>, 2> padding{{std::make_pair(pad, pad), std::make_pair(pad, pad)}};
+        r = a.pad(padding).convolve(b.reverse(reverse), dims);
+    } else {
+        r = a.convolve(b.reverse(reverse), dims);
+    }
+}
+
+// Batched multi-channel convolution with im2col and GEMM on Blaze matrices.
+// The images are [N, C, H, W], the filters [F, C, k, k] and the outputs
+// [N, F, H - k + 1, W - k + 1], one matrix per image.
+struct blaze_im2col {
+    std::size_t N, C, H, W, F, k, Ho, Wo;
+
+    std::vector<float> input;           ///< The images, [N, C, H, W]
+    std::vector<float> input_gradients; ///< The gradients of the images, [N, C, H, W]
+    blaze_smat filters;                 ///< The filters, [F, C * k * k]
+    blaze_smat filter_gradients;        ///< The gradients of the filters, [F, C * k * k]
+    blaze_smat cols;                    ///< The columns of one image, [C * k * k, Ho * Wo]
+    std::vector<blaze_smat> output;     ///< The outputs, or their gradients, N x [F, Ho * Wo]
+
+    blaze_im2col(std::size_t N, std::size_t C, std::size_t H, std::size_t F, std::size_t k)
+            : N(N), C(C), H(H), W(H), F(F), k(k), Ho(H - k + 1), Wo(H - k + 1),
+              input(N * C * H * H, 0.0f), input_gradients(N * C * H * H, 0.0f),
+              filters(F, C * k * k, 0.0f), filter_gradients(F, C * k * k, 0.0f), cols(C * k * k, Ho * Wo, 0.0f),
+              output(N, blaze_smat(F, Ho * Wo, 0.0f)) {
+        // The operands are not seen by the harness, they are filled here with the data of EVB_DATA
+        auto& config = evb::get_config();
+
+        evb::fill(input, config.data, config.seed);
+        evb::fill(filters, config.data, config.seed + 1);
+
+        for(std::size_t n = 0; n < N; ++n){
+            evb::fill(output[n], config.data, config.seed + 2 + n);
+        }
+    }
+
+    void im2col(std::size_t n){
+        const float* in = input.data() + n * C * H * W;
+
+        for(std::size_t c = 0; c < C; ++c){
+            for(std::size_t p = 0; p < k; ++p){
+                for(std::size_t q = 0; q < k; ++q){
+                    const std::size_t row = (c * k + p) * k + q;
+
+                    for(std::size_t y = 0; y < Ho; ++y){
+                        for(std::size_t x = 0; x < Wo; ++x){
+                            cols(row, y * Wo + x) = in[(c * H + y + p) * W + x + q];
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void col2im(std::size_t n){
+        float* out = input_gradients.data() + n * C * H * W;
+
+        std::fill(out, out + C * H * W, 0.0f);
+
+        for(std::size_t c = 0; c < C; ++c){
+            for(std::size_t p = 0; p < k; ++p){
+                for(std::size_t q = 0; q < k; ++q){
+                    const std::size_t row = (c * k + p) * k + q;
+
+                    for(std::size_t y = 0; y < Ho; ++y){
+                        for(std::size_t x = 0; x < Wo; ++x){
+                            out[(c * H + y + p) * W + x + q] += cols(row, y * Wo + x);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void forward(){
+        for(std::size_t n = 0; n < N; ++n){
+            im2col(n);
+            output[n] = filters * cols;
+        }
+    }
+
+    void backward_input(){
+        for(std::size_t n = 0; n < N; ++n){
+            cols = trans(filters) * output[n];
+            col2im(n);
+        }
+    }
+
+    void backward_filter(){
+        filter_gradients = 0.0f;
+
+        for(std::size_t n = 0; n < N; ++n){
+            im2col(n);
+            filter_gradients += output[n] * trans(cols);
+        }
+    }
+};
+
+// Pairs of (input size, kernel size)
+using conv_1d_policy = NARY_POLICY(
+    VALUES_POLICY(1000, 10000, 100000, 100000, 1000000),
+    VALUES_POLICY(9, 9, 33, 129, 129));
+
+using conv_2d_policy = NARY_POLICY(
+    VALUES_POLICY(28, 64, 128, 256, 512, 1024),
+    VALUES_POLICY(5, 3, 5, 7, 9, 17));
+
+EVB_SECTION_P("r = conv_1d_valid(a, b)", conv_1d_policy)
+    EVB_COST(float,
+        [](std::size_t n, std::size_t k){ return 2.0 * (n - k + 1) * k; },
+        [](std::size_t n, std::size_t k){ return 4.0 * (n + k + n - k + 1); });
+
+    EVB_TWO_PASS_NS("etl",
+        [](std::size_t n, std::size_t k){ return std::make_tuple(etl_svec(n), etl_svec(k), etl_svec(n - k + 1)); },
+        [](etl_svec& a, etl_svec& b, etl_svec& r){ r = etl::conv_1d_valid(a, b); });
+    EVB_TWO_PASS_NS("etl-std",
+        [](std::size_t n, std::size_t k){ return std::make_tuple(etl_svec(n), etl_svec(k), etl_svec(n - k + 1)); },
+        [](etl_svec& a, etl_svec& b, etl_svec& r){ r = selected_helper(etl::conv_impl::STD, etl::conv_1d_valid(a, b)); });
+    EVB_TWO_PASS_NS("etl-vec",
+        [](std::size_t n, std::size_t k){ return std::make_tuple(etl_svec(n), etl_svec(k), etl_svec(n - k + 1)); },
+        [](etl_svec& a, etl_svec& b, etl_svec& r){ r = selected_helper(etl::conv_impl::VEC, etl::conv_1d_valid(a, b)); });
+    EVB_TWO_PASS_NS("eigen-tensor",
+        [](std::size_t n, std::size_t k){ return std::make_tuple(zero_tensor<eigen_stensor1>(n), zero_tensor<eigen_stensor1>(k), zero_tensor<eigen_stensor1>(n - k + 1)); },
+        [](eigen_stensor1& a, eigen_stensor1& b, eigen_stensor1& r){ eigen_conv_1d(r, a, b, 0); });
+}
+
+EVB_SECTION_P("r = conv_1d_full(a, b)", conv_1d_policy)
+    EVB_COST(float,
+        [](std::size_t n, std::size_t k){ return 2.0 * n * k; },
+        [](std::size_t n, std::size_t k){ return 4.0 * (n + k + n + k - 1); });
+
+    EVB_TWO_PASS_NS("etl",
+        [](std::size_t n, std::size_t k){ return std::make_tuple(etl_svec(n), etl_svec(k), etl_svec(n + k - 1)); },
+        [](etl_svec& a, etl_svec& b, etl_svec& r){ r = etl::conv_1d_full(a, b); });
+    EVB_TWO_PASS_NS("etl-std",
+        [](std::size_t n, std::size_t k){ return std::make_tuple(etl_svec(n), etl_svec(k), etl_svec(n + k - 1)); },
+        [](etl_svec& a, etl_svec& b, etl_svec& r){ r = selected_helper(etl::conv_impl::STD, etl::conv_1d_full(a, b)); });
+    EVB_TWO_PASS_NS("etl-vec",
+        [](std::size_t n, std::size_t k){ return std::make_tuple(etl_svec(n), etl_svec(k), etl_svec(n + k - 1)); },
+        [](etl_svec& a, etl_svec& b, etl_svec& r){ r = selected_helper(etl::conv_impl::VEC, etl::conv_1d_full(a, b)); });
+    EVB_TWO_PASS_NS("etl-fft",
+        [](std::size_t n, std::size_t k){ return std::make_tuple(etl_svec(n), etl_svec(k), etl_svec(n + k - 1)); },
+        [](etl_svec& a, etl_svec& b, etl_svec& r){ r = selected_helper(etl::conv_impl::FFT_STD, etl::conv_1d_full(a, b)); });
+#ifdef ETL_MKL_MODE
+    EVB_TWO_PASS_NS("etl-fft-mkl",
+        [](std::size_t n, std::size_t k){ return std::make_tuple(etl_svec(n), etl_svec(k), etl_svec(n + k - 1)); },
+        [](etl_svec& a, etl_svec& b, etl_svec& r){ r = selected_helper(etl::conv_impl::FFT_MKL, etl::conv_1d_full(a, b)); });
+#endif
+    EVB_TWO_PASS_NS("eigen-tensor",
+        [](std::size_t n, std::size_t k){ return std::make_tuple(zero_tensor<eigen_stensor1>(n), zero_tensor<eigen_stensor1>(k), zero_tensor<eigen_stensor1>(n + k - 1)); },
+        [](eigen_stensor1& a, eigen_stensor1& b, eigen_stensor1& r){ eigen_conv_1d(r, a, b, b.dimension(0) - 1); });
+}
+
+EVB_SECTION_P("r = conv_1d_same(a, b)", conv_1d_policy)
+    EVB_COST(float,
+        [](std::size_t n, std::size_t k){ return 2.0 * n * k; },
+        [](std::size_t n, std::size_t k){ return 4.0 * (n + k + n); });
+
+    EVB_TWO_PASS_NS("etl",
+        [](std::size_t n, std::size_t k){ return std::make_tuple(etl_svec(n), etl_svec(k), etl_svec(n)); },
+        [](etl_svec& a, etl_svec& b, etl_svec& r){ r = etl::conv_1d_same(a, b); });
+    EVB_TWO_PASS_NS("etl-std",
+        [](std::size_t n, std::size_t k){ return std::make_tuple(etl_svec(n), etl_svec(k), etl_svec(n)); },
+        [](etl_svec& a, etl_svec& b, etl_svec& r){ r = selected_helper(etl::conv_impl::STD, etl::conv_1d_same(a, b)); });
+    EVB_TWO_PASS_NS("etl-vec",
+        [](std::size_t n, std::size_t k){ return std::make_tuple(etl_svec(n), etl_svec(k), etl_svec(n)); },
+        [](etl_svec& a, etl_svec& b, etl_svec& r){ r = selected_helper(etl::conv_impl::VEC, etl::conv_1d_same(a, b)); });
+    EVB_TWO_PASS_NS("eigen-tensor",
+        [](std::size_t n, std::size_t k){ return std::make_tuple(zero_tensor<eigen_stensor1>(n), zero_tensor<eigen_stensor1>(k), zero_tensor<eigen_stensor1>(n)); },
+        [](eigen_stensor1& a, eigen_stensor1& b, eigen_stensor1& r){ eigen_conv_1d(r, a, b, (b.dimension(0) - 1) / 2); });
+}
+
+EVB_SECTION_P("R = conv_2d_valid(A, B)", conv_2d_policy)
+    EVB_COST(float,
+        [](std::size_t n, std::size_t k){ return 2.0 * (n - k + 1) * (n - k + 1) * k * k; },
+        [](std::size_t n, std::size_t k){ return 4.0 * (n * n + k * k + (n - k + 1) * (n - k + 1)); });
+
+    EVB_TWO_PASS_NS("etl",
+        [](std::size_t n, std::size_t k){ return std::make_tuple(etl_smat(n, n), etl_smat(k, k), etl_smat(n - k + 1, n - k + 1)); },
+        [](etl_smat& A, etl_smat& B, etl_smat& R){ R = etl::conv_2d_valid(A, B); });
+    EVB_TWO_PASS_NS("etl-std",
+        [](std::size_t n, std::size_t k){ return std::make_tuple(etl_smat(n, n), etl_smat(k, k), etl_smat(n - k + 1, n - k + 1)); },
+        [](etl_smat& A, etl_smat& B, etl_smat& R){ R = selected_helper(etl::conv_impl::STD, etl::conv_2d_valid(A, B)); });
+    EVB_TWO_PASS_NS("etl-vec",
+        [](std::size_t n, std::size_t k){ return std::make_tuple(etl_smat(n, n), etl_smat(k, k), etl_smat(n - k + 1, n - k + 1)); },
+        [](etl_smat& A, etl_smat& B, etl_smat& R){ R = selected_helper(etl::conv_impl::VEC, etl::conv_2d_valid(A, B)); });
+    EVB_TWO_PASS_NS("eigen-tensor",
+        [](std::size_t n, std::size_t k){ return std::make_tuple(zero_tensor<eigen_stensor2>(n, n), zero_tensor<eigen_stensor2>(k, k), zero_tensor<eigen_stensor2>(n - k + 1, n - k + 1)); },
+        [](eigen_stensor2& A, eigen_stensor2& B, eigen_stensor2& R){ eigen_conv_2d(R, A, B, 0); });
+}
+
+EVB_SECTION_P("R = conv_2d_full(A, B)", conv_2d_policy)
+    EVB_COST(float,
+        [](std::size_t n, std::size_t k){ return 2.0 * n * n * k * k; },
+        [](std::size_t n, std::size_t k){ return 4.0 * (n * n + k * k + (n + k - 1) * (n + k - 1)); });
+
+    EVB_TWO_PASS_NS("etl",
+        [](std::size_t n, std::size_t k){ return std::make_tuple(etl_smat(n, n), etl_smat(k, k), etl_smat(n + k - 1, n + k - 1)); },
+        [](etl_smat& A, etl_smat& B, etl_smat& R){ R = etl::conv_2d_full(A, B); });
+    EVB_TWO_PASS_NS("etl-std",
+        [](std::size_t n, std::size_t k){ return std::make_tuple(etl_smat(n, n), etl_smat(k, k), etl_smat(n + k - 1, n + k - 1)); },
+        [](etl_smat& A, etl_smat& B, etl_smat& R){ R = selected_helper(etl::conv_impl::STD, etl::conv_2d_full(A, B)); });
+    EVB_TWO_PASS_NS("etl-vec",
+        [](std::size_t n, std::size_t k){ return std::make_tuple(etl_smat(n, n), etl_smat(k, k), etl_smat(n + k - 1, n + k - 1)); },
+        [](etl_smat& A, etl_smat& B, etl_smat& R){ R = selected_helper(etl::conv_impl::VEC, etl::conv_2d_full(A, B)); });
+    EVB_TWO_PASS_NS("etl-fft",
+        [](std::size_t n, std::size_t k){ return std::make_tuple(etl_smat(n, n), etl_smat(k, k), etl_smat(n + k - 1, n + k - 1)); },
+        [](etl_smat& A, etl_smat& B, etl_smat& R){ R = selected_helper(etl::conv_impl::FFT_STD, etl::conv_2d_full(A, B)); });
+#ifdef ETL_MKL_MODE
+    EVB_TWO_PASS_NS("etl-fft-mkl",
+        [](std::size_t n, std::size_t k){ return std::make_tuple(etl_smat(n, n), etl_smat(k, k), etl_smat(n + k - 1, n + k - 1)); },
+        [](etl_smat& A, etl_smat& B, etl_smat& R){ R = selected_helper(etl::conv_impl::FFT_MKL, etl::conv_2d_full(A, B)); });
+#endif
+    EVB_TWO_PASS_NS("eigen-tensor",
+        [](std::size_t n, std::size_t k){ return std::make_tuple(zero_tensor<eigen_stensor2>(n, n), zero_tensor<eigen_stensor2>(k, k), zero_tensor<eigen_stensor2>(n + k - 1, n + k - 1)); },
+        [](eigen_stensor2& A, eigen_stensor2& B, eigen_stensor2& R){ eigen_conv_2d(R, A, B, B.dimension(0) - 1); });
+}
+
+EVB_SECTION_P("R = conv_2d_same(A, B)", conv_2d_policy)
+    EVB_COST(float,
+        [](std::size_t n, std::size_t k){ return 2.0 * n * n * k * k; },
+        [](std::size_t n, std::size_t k){ return 4.0 * (n * n + k * k + n * n); });
+
+    EVB_TWO_PASS_NS("etl",
+        [](std::size_t n, std::size_t k){ return std::make_tuple(etl_smat(n, n), etl_smat(k, k), etl_smat(n, n)); },
+        [](etl_smat& A, etl_smat& B, etl_smat& R){ R = etl::conv_2d_same(A, B); });
+    EVB_TWO_PASS_NS("etl-std",
+        [](std::size_t n, std::size_t k){ return std::make_tuple(etl_smat(n, n), etl_smat(k, k), etl_smat(n, n)); },
+        [](etl_smat& A, etl_smat& B, etl_smat& R){ R = selected_helper(etl::conv_impl::STD, etl::conv_2d_same(A, B)); });
+    EVB_TWO_PASS_NS("etl-vec",
+        [](std::size_t n, std::size_t k){ return std::make_tuple(etl_smat(n, n), etl_smat(k, k), etl_smat(n, n)); },
+        [](etl_smat& A, etl_smat& B, etl_smat& R){ R = selected_helper(etl::conv_impl::VEC, etl::conv_2d_same(A, B)); });
+    EVB_TWO_PASS_NS("eigen-tensor",
+        [](std::size_t n, std::size_t k){ return std::make_tuple(zero_tensor<eigen_stensor2>(n, n), zero_tensor<eigen_stensor2>(k, k), zero_tensor<eigen_stensor2>(n, n)); },
+        [](eigen_stensor2& A, eigen_stensor2& B, eigen_stensor2& R){ eigen_conv_2d(R, A, B, (B.dimension(0) - 1) / 2); });
+}
+
+// Layers of convolutional networks: (batch, channels, image size, filters, kernel size)
+using conv_4d_policy = NARY_POLICY(
+    VALUES_POLICY(32, 32, 32, 16, 8),
+    VALUES_POLICY(1, 3, 32, 64, 128),
+    VALUES_POLICY(28, 32, 16, 14, 7),
+    VALUES_POLICY(32, 32, 64, 128, 256),
+    VALUES_POLICY(5, 3, 3, 3, 3));
+
+// The FLOPs and bytes of one batched convolution, or of one of its gradients
+const auto conv_4d_flops = [](std::size_t N, std::size_t C, std::size_t H, std::size_t F, std::size_t k){
+    return 2.0 * N * F * (H - k + 1) * (H - k + 1) * C * k * k;
+};
+
+const auto conv_4d_bytes = [](std::size_t N, std::size_t C, std::size_t H, std::size_t F, std::size_t k){
+    return 4.0 * (N * C * H * H + F * C * k * k + N * F * (H - k + 1) * (H - k + 1));
+};
+
+EVB_SECTION_P("O = conv_4d_valid(I, K)", conv_4d_policy)
+    EVB_COST(float, conv_4d_flops, conv_4d_bytes);
+
+    EVB_ITEMS("images", [](std::size_t N, std::size_t, std::size_t, std::size_t, std::size_t){ return 1.0 * N; });
+
+    EVB_TWO_PASS_NS("etl",
+        [](std::size_t N, std::size_t C, std::size_t H, std::size_t F, std::size_t k){ return std::make_tuple(etl_smat4(N, C, H, H), etl_smat4(F, C, k, k), etl_smat4(N, F, H - k + 1, H - k + 1)); },
+        [](etl_smat4& I, etl_smat4& K, etl_smat4& O){ O = etl::conv_4d_valid_flipped(I, K); });
+    EVB_TWO_PASS_NS("etl-std",
+        [](std::size_t N, std::size_t C, std::size_t H, std::size_t F, std::size_t k){ return std::make_tuple(etl_smat4(N, C, H, H), etl_smat4(F, C, k, k), etl_smat4(N, F, H - k + 1, H - k + 1)); },
+        [](etl_smat4& I, etl_smat4& K, etl_smat4& O){ O = selected_helper(etl::conv4_impl::STD, etl::conv_4d_valid_flipped(I, K)); });
+    EVB_TWO_PASS_NS("etl-vec",
+        [](std::size_t N, std::size_t C, std::size_t H, std::size_t F, std::size_t k){ return std::make_tuple(etl_smat4(N, C, H, H), etl_smat4(F, C, k, k), etl_smat4(N, F, H - k + 1, H - k + 1)); },
+        [](etl_smat4& I, etl_smat4& K, etl_smat4& O){ O = selected_helper(etl::conv4_impl::VEC, etl::conv_4d_valid_flipped(I, K)); });
+    EVB_TWO_PASS_NS("blaze-im2col",
+        [](std::size_t N, std::size_t C, std::size_t H, std::size_t F, std::size_t k){ return std::make_tuple(blaze_im2col(N, C, H, F, k)); },
+        [](blaze_im2col& conv){ conv.forward(); });
+}
+
+EVB_SECTION_P("dI = conv_4d_full(dO, K)", conv_4d_policy)
+    EVB_COST(float, conv_4d_flops, conv_4d_bytes);
+
+    EVB_ITEMS("images", [](std::size_t N, std::size_t, std::size_t, std::size_t, std::size_t){ return 1.0 * N; });
+
+    EVB_TWO_PASS_NS("etl",
+        [](std::size_t N, std::size_t C, std::size_t H, std::size_t F, std::size_t k){ return std::make_tuple(etl_smat4(N, F, H - k + 1, H - k + 1), etl_smat4(F, C, k, k), etl_smat4(N, C, H, H)); },
+        [](etl_smat4& dO, etl_smat4& K, etl_smat4& dI){ dI = etl::conv_4d_full(dO, K); });
+    EVB_TWO_PASS_NS("etl-std",
+        [](std::size_t N, std::size_t C, std::size_t H, std::size_t F, std::size_t k){ return std::make_tuple(etl_smat4(N, F, H - k + 1, H - k + 1), etl_smat4(F, C, k, k), etl_smat4(N, C, H, H)); },
+        [](etl_smat4& dO, etl_smat4& K, etl_smat4& dI){ dI = selected_helper(etl::conv4_impl::STD, etl::conv_4d_full(dO, K)); });
+    EVB_TWO_PASS_NS("etl-vec",
+        [](std::size_t N, std::size_t C, std::size_t H, std::size_t F, std::size_t k){ return std::make_tuple(etl_smat4(N, F, H - k + 1, H - k + 1), etl_smat4(F, C, k, k), etl_smat4(N, C, H, H)); },
+        [](etl_smat4& dO, etl_smat4& K, etl_smat4& dI){ dI = selected_helper(etl::conv4_impl::VEC, etl::conv_4d_full(dO, K)); });
+    EVB_TWO_PASS_NS("etl-fft",
+        [](std::size_t N, std::size_t C, std::size_t H, std::size_t F, std::size_t k){ return std::make_tuple(etl_smat4(N, F, H - k + 1, H - k + 1), etl_smat4(F, C, k, k), etl_smat4(N, C, H, H)); },
+        [](etl_smat4& dO, etl_smat4& K, etl_smat4& dI){ dI = selected_helper(etl::conv4_impl::FFT_STD, etl::conv_4d_full(dO, K)); });
+    EVB_TWO_PASS_NS("blaze-im2col",
+        [](std::size_t N, std::size_t C, std::size_t H, std::size_t F, std::size_t k){ return std::make_tuple(blaze_im2col(N, C, H, F, k)); },
+        [](blaze_im2col& conv){ conv.backward_input(); });
+}
+
+EVB_SECTION_P("dK = conv_4d_valid_filter(I, dO)", conv_4d_policy)
+    EVB_COST(float, conv_4d_flops, conv_4d_bytes);
+
+    EVB_ITEMS("images", [](std::size_t N, std::size_t, std::size_t, std::size_t, std::size_t){ return 1.0 * N; });
+
+    EVB_TWO_PASS_NS("etl",
+        [](std::size_t N, std::size_t C, std::size_t H, std::size_t F, std::size_t k){ return std::make_tuple(etl_smat4(N, C, H, H), etl_smat4(N, F, H - k + 1, H - k + 1), etl_smat4(F, C, k, k)); },
+        [](etl_smat4& I, etl_smat4& dO, etl_smat4& dK){ dK = etl::conv_4d_valid_filter_flipped(I, dO); });
+    EVB_TWO_PASS_NS("etl-std",
+        [](std::size_t N, std::size_t C, std::size_t H, std::size_t F, std::size_t k){ return std::make_tuple(etl_smat4(N, C, H, H), etl_smat4(N, F, H - k + 1, H - k + 1), etl_smat4(F, C, k, k)); },
+        [](etl_smat4& I, etl_smat4& dO, etl_smat4& dK){ dK = selected_helper(etl::conv4_impl::STD, etl::conv_4d_valid_filter_flipped(I, dO)); });
+    EVB_TWO_PASS_NS("etl-vec",
+        [](std::size_t N, std::size_t C, std::size_t H, std::size_t F, std::size_t k){ return std::make_tuple(etl_smat4(N, C, H, H), etl_smat4(N, F, H - k + 1, H - k + 1), etl_smat4(F, C, k, k)); },
+        [](etl_smat4& I, etl_smat4& dO, etl_smat4& dK){ dK = selected_helper(etl::conv4_impl::VEC, etl::conv_4d_valid_filter_flipped(I, dO)); });
+    EVB_TWO_PASS_NS("blaze-im2col",
+        [](std::size_t N, std::size_t C, std::size_t H, std::size_t F, std::size_t k){ return std::make_tuple(blaze_im2col(N, C, H, F, k)); },
+        [](blaze_im2col& conv){ conv.backward_filter(); });
+}
+
+// Feature maps of convolutional networks: (batch, channels, image size), pooled by 2x2
+using pool_policy = NARY_POLICY(
+    VALUES_POLICY(32, 32, 16, 8),
+    VALUES_POLICY(32, 64, 128, 256),
+    VALUES_POLICY(28, 56, 28, 14));
+
+// Reference 2x2 pooling over raw [N, C, H, W] buffers
+template<typename Reduce>
+void loop_pool(const std::vector<float>& in, std::vector<float>& out, std::size_t H, Reduce reduce){
+    const std::size_t Ho = H / 2;
+    const std::size_t maps = in.size() / (H * H);
+
+    for(std::size_t m = 0; m < maps; ++m){
+        const float* a = in.data() + m * H * H;
+        float* r = out.data() + m * Ho * Ho;
+
+        for(std::size_t y = 0; y < Ho; ++y){
+            for(std::size_t x = 0; x < Ho; ++x){
+                const float* p = a + 2 * y * H + 2 * x;
+                r[y * Ho + x] = reduce(reduce(p[0], p[1]), reduce(p[H], p[H + 1]));
+            }
+        }
+    }
+}
+
+// Eigen pools by reducing the 2x2 blocks of a reshaped tensor
+void eigen_pool(const eigen_stensor4& in, eigen_stensor4& out, bool max){
+    const Eigen::Index rows = in.dimension(0) * in.dimension(1) * in.dimension(2) / 2;
+    const Eigen::Index Wo   = in.dimension(3) / 2;
+
+    Eigen::array<Eigen::Index, 4> blocks{{rows, 2, Wo, 2}};
+    Eigen::array<Eigen::Index, 2> reduced{{1, 3}};
+
+    if(max){
+        out.reshape(Eigen::array<Eigen::Index, 2>{{rows, Wo}}) = in.reshape(blocks).maximum(reduced);
+    } else {
+        out.reshape(Eigen::array<Eigen::Index, 2>{{rows, Wo}}) = in.reshape(blocks).mean(reduced);
+    }
+}
+
+EVB_SECTION_P("O = max_pool_2d(I, 2, 2)", pool_policy)
+    EVB_COST(float,
+        [](std::size_t N, std::size_t C, std::size_t H){ return 1.0 * N * C * H * H; },
+        [](std::size_t N, std::size_t C, std::size_t H){ return 4.0 * (N * C * H * H + N * C * H * H / 4); });
+
+    EVB_TWO_PASS_NS("etl",
+        [](std::size_t N, std::size_t C, std::size_t H){ return std::make_tuple(etl_smat4(N, C, H, H), etl_smat4(N, C, H / 2, H / 2)); },
+        [](etl_smat4& I, etl_smat4& O){ O = etl::max_pool_2d<2, 2>(I); });
+    EVB_TWO_PASS_NS("eigen-tensor",
+        [](std::size_t N, std::size_t C, std::size_t H){ return std::make_tuple(zero_tensor<eigen_stensor4>(N, C, H, H), zero_tensor<eigen_stensor4>(N, C, H / 2, H / 2)); },
+        [](eigen_stensor4& I, eigen_stensor4& O){ eigen_pool(I, O, true); });
+    EVB_TWO_PASS_NS("loop",
+        [](std::size_t N, std::size_t C, std::size_t H){ return std::make_tuple(std::vector<float>(N * C * H * H), std::vector<float>(N * C * H * H / 4), H); },
+        [](std::vector<float>& I, std::vector<float>& O, std::size_t H){ loop_pool(I, O, H, [](float a, float b){ return std::max(a, b); }); });
+}
+
+EVB_SECTION_P("O = avg_pool_2d(I, 2, 2)", pool_policy)
+    EVB_COST(float,
+        [](std::size_t N, std::size_t C, std::size_t H){ return 1.0 * N * C * H * H; },
+        [](std::size_t N, std::size_t C, std::size_t H){ return 4.0 * (N * C * H * H + N * C * H * H / 4); });
+
+    EVB_TWO_PASS_NS("etl",
+        [](std::size_t N, std::size_t C, std::size_t H){ return std::make_tuple(etl_smat4(N, C, H, H), etl_smat4(N, C, H / 2, H / 2)); },
+        [](etl_smat4& I, etl_smat4& O){ O = etl::avg_pool_2d<2, 2>(I); });
+    EVB_TWO_PASS_NS("eigen-tensor",
+        [](std::size_t N, std::size_t C, std::size_t H){ return std::make_tuple(zero_tensor<eigen_stensor4>(N, C, H, H), zero_tensor<eigen_stensor4>(N, C, H / 2, H / 2)); },
+        [](eigen_stensor4& I, eigen_stensor4& O){ eigen_pool(I, O, false); });
+    EVB_TWO_PASS_NS("loop",
+        [](std::size_t N, std::size_t C, std::size_t H){ return std::make_tuple(std::vector<float>(N * C * H * H), std::vector<float>(N * C * H * H / 4), H); },
+        [](std::vector<float>& I, std::vector<float>& O, std::size_t H){ loop_pool(I, O, H, [](float a, float b){ return 0.5f * (a + b); }); });
+}
+
+} //end of anonymous namespace
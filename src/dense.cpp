@@ -0,0 +1,234 @@
+#define CPM_LIB
+#include "benchmark.hpp"
+
+#include <cmath>
+
+// A fully-connected layer of a neural network, Y = f(X * W + b), forward and
+// backward, in single precision, written the natural way for each library.
+// Each library is also measured with only the GEMMs of the layer ("-gemm"),
+// the difference is reported as a number of full passes over a batch-sized
+// matrix, showing whether the bias and the activation are fused or not.
+
+namespace {
+
+enum class activation {
+    sigmoid,
+    relu
+};
+
+using blaze_svec_row = blaze_dyn_vector_row<float>;
+
+// The operands inside the layers are not seen by the harness, they are filled here with the data of EVB_DATA
+template<typename... M>
+void fill_layer(M&... m){
+    auto& config     = evb::get_config();
+    std::size_t seed = config.seed;
+
+    int filled[] = {0, (evb::fill(m, config.data, seed++), 0)...};
+    (void)filled;
+}
+
+// X is [B, N], W is [N, N], b is [N], Y is [B, N]
+template<activation A>
+struct etl_layer {
+    etl_smat X, W, Y, dY, dZ, dW, dX;
+    etl_svec b, db;
+
+    etl_layer(std::size_t B, std::size_t N) : X(B, N), W(N, N), Y(B, N), dY(B, N), dZ(B, N), dW(N, N), dX(B, N), b(N), db(N) {
+        fill_layer(X, W, b, Y, dY, dZ);
+    }
+
+    void forward_gemm(){
+        Y = X * W;
+    }
+
+    void forward(){
+        if(A == activation::sigmoid){
+            Y = etl::sigmoid(etl::bias_add_2d(X * W, b));
+        } else {
+            Y = etl::relu(etl::bias_add_2d(X * W, b));
+        }
+    }
+
+    void backward_gemm(){
+        dW = etl::transpose(X) * dZ;
+        dX = dZ * etl::transpose(W);
+    }
+
+    void backward(){
+        if(A == activation::sigmoid){
+            dZ = dY >> Y >> (1.0f - Y);
+        } else {
+            dZ = dY >> etl::relu_derivative(Y);
+        }
+
+        dW = etl::transpose(X) * dZ;
+        dX = dZ * etl::transpose(W);
+        db = etl::bias_batch_sum_2d(dZ);
+    }
+};
+
+template<activation A>
+struct blaze_layer {
+    blaze_smat X, W, Y, dY, dZ, dW, dX;
+    blaze_svec_row b, db;
+
+    blaze_layer(std::size_t B, std::size_t N) : X(B, N, 0.0f), W(N, N, 0.0f), Y(B, N, 0.0f), dY(B, N, 0.0f), dZ(B, N, 0.0f), dW(N, N, 0.0f), dX(B, N, 0.0f), b(N, 0.0f), db(N, 0.0f) {
+        fill_layer(X, W, b, Y, dY, dZ);
+    }
+
+    void forward_gemm(){
+        Y = X * W;
+    }
+
+    void forward(){
+        Y = X * W;
+
+        for(std::size_t i = 0; i < Y.rows(); ++i){
+            blaze::row(Y, i) += b;
+        }
+
+        if(A == activation::sigmoid){
+            Y = blaze::map(Y, [](float x){ return 1.0f / (1.0f + std::exp(-x)); });
+        } else {
+            Y = blaze::map(Y, [](float x){ return x > 0.0f ? x : 0.0f; });
+        }
+    }
+
+    void backward_gemm(){
+        dW = blaze::trans(X) * dZ;
+        dX = dZ * blaze::trans(W);
+    }
+
+    void backward(){
+        if(A == activation::sigmoid){
+            dZ = blaze::map(Y, dY, [](float y, float d){ return d * y * (1.0f - y); });
+        } else {
+            dZ = blaze::map(Y, dY, [](float y, float d){ return y > 0.0f ? d : 0.0f; });
+        }
+
+        dW = blaze::trans(X) * dZ;
+        dX = dZ * blaze::trans(W);
+
+        db = 0.0f;
+
+        for(std::size_t i = 0; i < dZ.rows(); ++i){
+            db += blaze::row(dZ, i);
+        }
+    }
+};
+
+template<activation A>
+struct eigen_layer {
+    eigen_smat_rm X, W, Y, dY, dZ, dW, dX;
+    Eigen::RowVectorXf b, db;
+
+    eigen_layer(std::size_t B, std::size_t N) : X(eigen_smat_rm::Zero(B, N)), W(eigen_smat_rm::Zero(N, N)), Y(eigen_smat_rm::Zero(B, N)), dY(eigen_smat_rm::Zero(B, N)),
+            dZ(eigen_smat_rm::Zero(B, N)), dW(eigen_smat_rm::Zero(N, N)), dX(eigen_smat_rm::Zero(B, N)), b(Eigen::RowVectorXf::Zero(N)), db(Eigen::RowVectorXf::Zero(N)) {
+        fill_layer(X, W, b, Y, dY, dZ);
+    }
+
+    void forward_gemm(){
+        Y.noalias() = X * W;
+    }
+
+    void forward(){
+        Y.noalias() = X * W;
+        Y.rowwise() += b;
+
+        if(A == activation::sigmoid){
+            Y.array() = (1.0f + (-Y.array()).exp()).inverse();
+        } else {
+            Y = Y.cwiseMax(0.0f);
+        }
+    }
+
+    void backward_gemm(){
+        dW.noalias() = X.transpose() * dZ;
+        dX.noalias() = dZ * W.transpose();
+    }
+
+    void backward(){
+        if(A == activation::sigmoid){
+            dZ.array() = dY.array() * Y.array() * (1.0f - Y.array());
+        } else {
+            dZ.array() = (Y.array() > 0.0f).select(dY.array(), 0.0f);
+        }
+
+        dW.noalias() = X.transpose() * dZ;
+        dX.noalias() = dZ * W.transpose();
+        db = dZ.colwise().sum();
+    }
+};
+
+// Pairs of (batch size, layer size)
+using dense_policy = NARY_POLICY(
+    VALUES_POLICY(1, 2, 4, 8, 16, 32, 64, 128, 256, 512, 1024),
+    VALUES_POLICY(1024, 1024, 1024, 1024, 1024, 1024, 1024, 1024, 1024, 1024, 1024));
+
+#define DENSE_FORWARD_SECTION(ACT)                                                                        \
+    EVB_SECTION_P("Y = " #ACT "(X * W + b)", dense_policy)                                                \
+        EVB_COST(float,                                                                                   \
+            [](std::size_t b, std::size_t n){ return 2.0 * b * n * n + 2.0 * b * n; },                    \
+            [](std::size_t b, std::size_t n){ return 4.0 * (2 * b * n + n * n + n); });                   \
+                                                                                                          \
+        EVB_ITEMS("samples", [](std::size_t b, std::size_t){ return 1.0 * b; });                          \
+                                                                                                          \
+        EVB_PASSES("-gemm", [](std::size_t b, std::size_t n){ return 4.0 * b * n; });                     \
+                                                                                                          \
+        EVB_TWO_PASS_NS("etl",                                                                            \
+            [](std::size_t b, std::size_t n){ return std::make_tuple(etl_layer<activation::ACT>(b, n)); },   \
+            [](etl_layer<activation::ACT>& layer){ layer.forward(); });                                   \
+        EVB_TWO_PASS_NS("etl-gemm",                                                                       \
+            [](std::size_t b, std::size_t n){ return std::make_tuple(etl_layer<activation::ACT>(b, n)); },   \
+            [](etl_layer<activation::ACT>& layer){ layer.forward_gemm(); });                              \
+        EVB_TWO_PASS_NS("blaze",                                                                          \
+            [](std::size_t b, std::size_t n){ return std::make_tuple(blaze_layer<activation::ACT>(b, n)); }, \
+            [](blaze_layer<activation::ACT>& layer){ layer.forward(); });                                 \
+        EVB_TWO_PASS_NS("blaze-gemm",                                                                     \
+            [](std::size_t b, std::size_t n){ return std::make_tuple(blaze_layer<activation::ACT>(b, n)); }, \
+            [](blaze_layer<activation::ACT>& layer){ layer.forward_gemm(); });                            \
+        EVB_TWO_PASS_NS("eigen",                                                                          \
+            [](std::size_t b, std::size_t n){ return std::make_tuple(eigen_layer<activation::ACT>(b, n)); }, \
+            [](eigen_layer<activation::ACT>& layer){ layer.forward(); });                                 \
+        EVB_TWO_PASS_NS("eigen-gemm",                                                                     \
+            [](std::size_t b, std::size_t n){ return std::make_tuple(eigen_layer<activation::ACT>(b, n)); }, \
+            [](eigen_layer<activation::ACT>& layer){ layer.forward_gemm(); });                            \
+    }
+
+#define DENSE_BACKWARD_SECTION(ACT)                                                                       \
+    EVB_SECTION_P("dW, dX, db of " #ACT "(X * W + b)", dense_policy)                                      \
+        EVB_COST(float,                                                                                   \
+            [](std::size_t b, std::size_t n){ return 4.0 * b * n * n + 4.0 * b * n; },                    \
+            [](std::size_t b, std::size_t n){ return 4.0 * (4 * b * n + 2 * n * n + n); });               \
+                                                                                                          \
+        EVB_ITEMS("samples", [](std::size_t b, std::size_t){ return 1.0 * b; });                          \
+                                                                                                          \
+        EVB_PASSES("-gemm", [](std::size_t b, std::size_t n){ return 4.0 * b * n; });                     \
+                                                                                                          \
+        EVB_TWO_PASS_NS("etl",                                                                            \
+            [](std::size_t b, std::size_t n){ return std::make_tuple(etl_layer<activation::ACT>(b, n)); },   \
+            [](etl_layer<activation::ACT>& layer){ layer.backward(); });                                  \
+        EVB_TWO_PASS_NS("etl-gemm",                                                                       \
+            [](std::size_t b, std::size_t n){ return std::make_tuple(etl_layer<activation::ACT>(b, n)); },   \
+            [](etl_layer<activation::ACT>& layer){ layer.backward_gemm(); });                             \
+        EVB_TWO_PASS_NS("blaze",                                                                          \
+            [](std::size_t b, std::size_t n){ return std::make_tuple(blaze_layer<activation::ACT>(b, n)); }, \
+            [](blaze_layer<activation::ACT>& layer){ layer.backward(); });                                \
+        EVB_TWO_PASS_NS("blaze-gemm",                                                                     \
+            [](std::size_t b, std::size_t n){ return std::make_tuple(blaze_layer<activation::ACT>(b, n)); }, \
+            [](blaze_layer<activation::ACT>& layer){ layer.backward_gemm(); });                           \
+        EVB_TWO_PASS_NS("eigen",                                                                          \
+            [](std::size_t b, std::size_t n){ return std::make_tuple(eigen_layer<activation::ACT>(b, n)); }, \
+            [](eigen_layer<activation::ACT>& layer){ layer.backward(); });                                \
+        EVB_TWO_PASS_NS("eigen-gemm",                                                                     \
+            [](std::size_t b, std::size_t n){ return std::make_tuple(eigen_layer<activation::ACT>(b, n)); }, \
+            [](eigen_layer<activation::ACT>& layer){ layer.backward_gemm(); });                           \
+    }
+
+DENSE_FORWARD_SECTION(sigmoid)
+DENSE_FORWARD_SECTION(relu)
+DENSE_BACKWARD_SECTION(sigmoid)
+DENSE_BACKWARD_SECTION(relu)
+
+} //end of anonymous namespace
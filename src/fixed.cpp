@@ -0,0 +1,330 @@
+#define CPM_LIB
+#include "benchmark.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+#include <tuple>
+#include <vector>
+
+// Small matrices with sizes known at compile-time (stack storage, fully
+// unrolled kernels), next to the same operations on dynamic matrices of the
+// same size. Each section is generated once per size.
+//
+// A single operation on such matrices takes a few nanoseconds, less than the
+// timers around each call. Each call therefore runs the operation on a batch
+// of independent operands, of about 2048 elements each, and the report gives
+// the number of operations per second ("ops").
+
+namespace {
+
+template<std::size_t N>
+using etl_fdvec = etl_fast_vector<double, N>;
+
+template<std::size_t N>
+using blaze_fdvec = blaze_static_vector<double, N>;
+
+template<std::size_t N>
+using eigen_fdvec = eigen_fixed_vector<double, N>;
+
+template<std::size_t N>
+using etl_fdmat = etl_fast_matrix<double, N, N>;
+
+template<std::size_t N>
+using blaze_fdmat = blaze_static_matrix<double, N, N>;
+
+template<std::size_t N>
+using eigen_fdmat = eigen_fixed_matrix<double, N, N>;
+
+// Aligned on a cache line, enough for the vectorized kernels of every library
+template<typename T>
+struct aligned_allocator {
+    using value_type = T;
+
+    aligned_allocator() = default;
+
+    template<typename U>
+    aligned_allocator(const aligned_allocator<U>& /*rhs*/){}
+
+    T* allocate(std::size_t n){
+        void* memory = nullptr;
+
+        if(posix_memalign(&memory, 64, n * sizeof(T))){
+            throw std::bad_alloc();
+        }
+
+        return static_cast<T*>(memory);
+    }
+
+    void deallocate(T* memory, std::size_t /*n*/){
+        std::free(memory);
+    }
+
+    template<typename U>
+    bool operator==(const aligned_allocator<U>& /*rhs*/) const {
+        return true;
+    }
+
+    template<typename U>
+    bool operator!=(const aligned_allocator<U>& /*rhs*/) const {
+        return false;
+    }
+};
+
+// The batches of operands of each call
+template<typename T>
+using batch = std::vector<T, aligned_allocator<T>>;
+
+// The number of operations of each call for matrices of dimension n
+std::size_t batch_of(std::size_t n){
+    return std::max<std::size_t>(1, 2048 / (n * n));
+}
+
+// Batches of copies of the given operands, for matrices of dimension n
+template<typename... T>
+std::tuple<batch<T>...> make_batches(std::size_t n, const T&... values){
+    return std::make_tuple(batch<T>(batch_of(n), values)...);
+}
+
+// Make A diagonally dominant so that it can be inverted
+template<typename M>
+M& make_invertible(M& A, std::size_t n){
+    for(std::size_t i = 0; i < n; ++i){
+        for(std::size_t j = 0; j < n; ++j){
+            A(i, j) = i == j ? double(n) : 1.0 / (1.0 + i + j);
+        }
+    }
+
+    return A;
+}
+
+
+#define FIXED_MIX_SECTION(N)                                                                                                                      \
+    EVB_SECTION_P("R = A + A * 5.9 + B - B / 2.3 (" #N "x" #N ")", VALUES_POLICY(N))                                                              \
+        EVB_COST(double,                                                                                                                          \
+            [](std::size_t d){ return 5.0 * d * d * batch_of(d); },                                                                               \
+            [](std::size_t d){ return 3.0 * 8 * d * d * batch_of(d); });                                                                          \
+                                                                                                                                                  \
+        EVB_ITEMS("ops", [](std::size_t d){ return 1.0 * batch_of(d); });                                                                         \
+                                                                                                                                                  \
+        EVB_TWO_PASS_NS("etl-fast",                                                                                                               \
+            [](std::size_t d){ return make_batches(d, etl_fdmat<N>(0.0), etl_fdmat<N>(0.0), etl_fdmat<N>(0.0)); },                                \
+            [](batch<etl_fdmat<N>>& R, batch<etl_fdmat<N>>& A, batch<etl_fdmat<N>>& B){                                                           \
+                for(std::size_t i = 0; i < R.size(); ++i){ R[i] = A[i] + A[i] * 5.9 + B[i] - B[i] / 2.3; }                                        \
+            });                                                                                                                                   \
+        EVB_TWO_PASS_NS("etl-dyn",                                                                                                                \
+            [](std::size_t d){ return make_batches(d, etl_dmat(d, d), etl_dmat(d, d), etl_dmat(d, d)); },                                         \
+            [](batch<etl_dmat>& R, batch<etl_dmat>& A, batch<etl_dmat>& B){                                                                       \
+                for(std::size_t i = 0; i < R.size(); ++i){ R[i] = A[i] + A[i] * 5.9 + B[i] - B[i] / 2.3; }                                        \
+            });                                                                                                                                   \
+        EVB_TWO_PASS_NS("blaze-static",                                                                                                           \
+            [](std::size_t d){ return make_batches(d, blaze_fdmat<N>(0.0), blaze_fdmat<N>(0.0), blaze_fdmat<N>(0.0)); },                          \
+            [](batch<blaze_fdmat<N>>& R, batch<blaze_fdmat<N>>& A, batch<blaze_fdmat<N>>& B){                                                     \
+                for(std::size_t i = 0; i < R.size(); ++i){ R[i] = A[i] + A[i] * 5.9 + B[i] - B[i] / 2.3; }                                        \
+            });                                                                                                                                   \
+        EVB_TWO_PASS_NS("blaze-dyn",                                                                                                              \
+            [](std::size_t d){ return make_batches(d, blaze_dmat(d, d), blaze_dmat(d, d), blaze_dmat(d, d)); },                                   \
+            [](batch<blaze_dmat>& R, batch<blaze_dmat>& A, batch<blaze_dmat>& B){                                                                 \
+                for(std::size_t i = 0; i < R.size(); ++i){ R[i] = A[i] + A[i] * 5.9 + B[i] - B[i] / 2.3; }                                        \
+            });                                                                                                                                   \
+        EVB_TWO_PASS_NS("eigen-fixed",                                                                                                            \
+            [](std::size_t d){ return make_batches(d, eigen_fdmat<N>::Zero().eval(), eigen_fdmat<N>::Zero().eval(), eigen_fdmat<N>::Zero().eval()); }, \
+            [](batch<eigen_fdmat<N>>& R, batch<eigen_fdmat<N>>& A, batch<eigen_fdmat<N>>& B){                                                     \
+                for(std::size_t i = 0; i < R.size(); ++i){ R[i] = A[i] + A[i] * 5.9 + B[i] - B[i] / 2.3; }                                        \
+            });                                                                                                                                   \
+        EVB_TWO_PASS_NS("eigen-dyn",                                                                                                              \
+            [](std::size_t d){ return make_batches(d, eigen_dmat(d, d), eigen_dmat(d, d), eigen_dmat(d, d)); },                                   \
+            [](batch<eigen_dmat>& R, batch<eigen_dmat>& A, batch<eigen_dmat>& B){                                                                 \
+                for(std::size_t i = 0; i < R.size(); ++i){ R[i] = A[i] + A[i] * 5.9 + B[i] - B[i] / 2.3; }                                        \
+            });                                                                                                                                   \
+    }
+
+#define FIXED_GEMV_SECTION(N)                                                                                                                     \
+    EVB_SECTION_P("r = A * b (" #N "x" #N ")", VALUES_POLICY(N))                                                                                  \
+        EVB_COST(double,                                                                                                                          \
+            [](std::size_t d){ return 2.0 * d * d * batch_of(d); },                                                                               \
+            [](std::size_t d){ return 8.0 * (d * d + 2 * d) * batch_of(d); });                                                                    \
+                                                                                                                                                  \
+        EVB_ITEMS("ops", [](std::size_t d){ return 1.0 * batch_of(d); });                                                                         \
+                                                                                                                                                  \
+        EVB_TWO_PASS_NS("etl-fast",                                                                                                               \
+            [](std::size_t d){ return make_batches(d, etl_fdmat<N>(0.0), etl_fdvec<N>(0.0), etl_fdvec<N>(0.0)); },                                \
+            [](batch<etl_fdmat<N>>& A, batch<etl_fdvec<N>>& b, batch<etl_fdvec<N>>& r){                                                           \
+                for(std::size_t i = 0; i < r.size(); ++i){ r[i] = A[i] * b[i]; }                                                                  \
+            });                                                                                                                                   \
+        EVB_TWO_PASS_NS("etl-dyn",                                                                                                                \
+            [](std::size_t d){ return make_batches(d, etl_dmat(d, d), etl_dvec(d), etl_dvec(d)); },                                               \
+            [](batch<etl_dmat>& A, batch<etl_dvec>& b, batch<etl_dvec>& r){                                                                       \
+                for(std::size_t i = 0; i < r.size(); ++i){ r[i] = A[i] * b[i]; }                                                                  \
+            });                                                                                                                                   \
+        EVB_TWO_PASS_NS("blaze-static",                                                                                                           \
+            [](std::size_t d){ return make_batches(d, blaze_fdmat<N>(0.0), blaze_fdvec<N>(0.0), blaze_fdvec<N>(0.0)); },                          \
+            [](batch<blaze_fdmat<N>>& A, batch<blaze_fdvec<N>>& b, batch<blaze_fdvec<N>>& r){                                                     \
+                for(std::size_t i = 0; i < r.size(); ++i){ r[i] = A[i] * b[i]; }                                                                  \
+            });                                                                                                                                   \
+        EVB_TWO_PASS_NS("blaze-dyn",                                                                                                              \
+            [](std::size_t d){ return make_batches(d, blaze_dmat(d, d), blaze_dvec(d), blaze_dvec(d)); },                                         \
+            [](batch<blaze_dmat>& A, batch<blaze_dvec>& b, batch<blaze_dvec>& r){                                                                 \
+                for(std::size_t i = 0; i < r.size(); ++i){ r[i] = A[i] * b[i]; }                                                                  \
+            });                                                                                                                                   \
+        EVB_TWO_PASS_NS("eigen-fixed",                                                                                                            \
+            [](std::size_t d){ return make_batches(d, eigen_fdmat<N>::Zero().eval(), eigen_fdvec<N>::Zero().eval(), eigen_fdvec<N>::Zero().eval()); }, \
+            [](batch<eigen_fdmat<N>>& A, batch<eigen_fdvec<N>>& b, batch<eigen_fdvec<N>>& r){                                                     \
+                for(std::size_t i = 0; i < r.size(); ++i){ r[i] = A[i] * b[i]; }                                                                  \
+            });                                                                                                                                   \
+        EVB_TWO_PASS_NS("eigen-dyn",                                                                                                              \
+            [](std::size_t d){ return make_batches(d, eigen_dmat(d, d), eigen_dvec(d), eigen_dvec(d)); },                                         \
+            [](batch<eigen_dmat>& A, batch<eigen_dvec>& b, batch<eigen_dvec>& r){                                                                 \
+                for(std::size_t i = 0; i < r.size(); ++i){ r[i] = A[i] * b[i]; }                                                                  \
+            });                                                                                                                                   \
+    }
+
+#define FIXED_GEMM_SECTION(N)                                                                                                                     \
+    EVB_SECTION_P("R = A * B (" #N "x" #N ")", VALUES_POLICY(N))                                                                                  \
+        EVB_COST(double,                                                                                                                          \
+            [](std::size_t d){ return 2.0 * d * d * d * batch_of(d); },                                                                           \
+            [](std::size_t d){ return 3.0 * 8 * d * d * batch_of(d); });                                                                          \
+                                                                                                                                                  \
+        EVB_ITEMS("ops", [](std::size_t d){ return 1.0 * batch_of(d); });                                                                         \
+                                                                                                                                                  \
+        EVB_TWO_PASS_NS("etl-fast",                                                                                                               \
+            [](std::size_t d){ return make_batches(d, etl_fdmat<N>(0.0), etl_fdmat<N>(0.0), etl_fdmat<N>(0.0)); },                                \
+            [](batch<etl_fdmat<N>>& A, batch<etl_fdmat<N>>& B, batch<etl_fdmat<N>>& R){                                                           \
+                for(std::size_t i = 0; i < R.size(); ++i){ R[i] = A[i] * B[i]; }                                                                  \
+            });                                                                                                                                   \
+        EVB_TWO_PASS_NS("etl-dyn",                                                                                                                \
+            [](std::size_t d){ return make_batches(d, etl_dmat(d, d), etl_dmat(d, d), etl_dmat(d, d)); },                                         \
+            [](batch<etl_dmat>& A, batch<etl_dmat>& B, batch<etl_dmat>& R){                                                                       \
+                for(std::size_t i = 0; i < R.size(); ++i){ R[i] = A[i] * B[i]; }                                                                  \
+            });                                                                                                                                   \
+        EVB_TWO_PASS_NS("blaze-static",                                                                                                           \
+            [](std::size_t d){ return make_batches(d, blaze_fdmat<N>(0.0), blaze_fdmat<N>(0.0), blaze_fdmat<N>(0.0)); },                          \
+            [](batch<blaze_fdmat<N>>& A, batch<blaze_fdmat<N>>& B, batch<blaze_fdmat<N>>& R){                                                     \
+                for(std::size_t i = 0; i < R.size(); ++i){ R[i] = A[i] * B[i]; }                                                                  \
+            });                                                                                                                                   \
+        EVB_TWO_PASS_NS("blaze-dyn",                                                                                                              \
+            [](std::size_t d){ return make_batches(d, blaze_dmat(d, d), blaze_dmat(d, d), blaze_dmat(d, d)); },                                   \
+            [](batch<blaze_dmat>& A, batch<blaze_dmat>& B, batch<blaze_dmat>& R){                                                                 \
+                for(std::size_t i = 0; i < R.size(); ++i){ R[i] = A[i] * B[i]; }                                                                  \
+            });                                                                                                                                   \
+        EVB_TWO_PASS_NS("eigen-fixed",                                                                                                            \
+            [](std::size_t d){ return make_batches(d, eigen_fdmat<N>::Zero().eval(), eigen_fdmat<N>::Zero().eval(), eigen_fdmat<N>::Zero().eval()); }, \
+            [](batch<eigen_fdmat<N>>& A, batch<eigen_fdmat<N>>& B, batch<eigen_fdmat<N>>& R){                                                     \
+                for(std::size_t i = 0; i < R.size(); ++i){ R[i] = A[i] * B[i]; }                                                                  \
+            });                                                                                                                                   \
+        EVB_TWO_PASS_NS("eigen-dyn",                                                                                                              \
+            [](std::size_t d){ return make_batches(d, eigen_dmat(d, d), eigen_dmat(d, d), eigen_dmat(d, d)); },                                   \
+            [](batch<eigen_dmat>& A, batch<eigen_dmat>& B, batch<eigen_dmat>& R){                                                                 \
+                for(std::size_t i = 0; i < R.size(); ++i){ R[i] = A[i] * B[i]; }                                                                  \
+            });                                                                                                                                   \
+    }
+
+#define FIXED_TRANSPOSE_SECTION(N)                                                                                                                \
+    EVB_SECTION_P("R = A' (" #N "x" #N ")", VALUES_POLICY(N))                                                                                     \
+        EVB_COST(double,                                                                                                                          \
+            [](std::size_t d){ return 0.0 * d; },                                                                                                 \
+            [](std::size_t d){ return 2.0 * 8 * d * d * batch_of(d); });                                                                          \
+                                                                                                                                                  \
+        EVB_ITEMS("ops", [](std::size_t d){ return 1.0 * batch_of(d); });                                                                         \
+                                                                                                                                                  \
+        EVB_TWO_PASS_NS("etl-fast",                                                                                                               \
+            [](std::size_t d){ return make_batches(d, etl_fdmat<N>(0.0), etl_fdmat<N>(0.0)); },                                                   \
+            [](batch<etl_fdmat<N>>& R, batch<etl_fdmat<N>>& A){                                                                                   \
+                for(std::size_t i = 0; i < R.size(); ++i){ R[i] = etl::transpose(A[i]); }                                                         \
+            });                                                                                                                                   \
+        EVB_TWO_PASS_NS("etl-dyn",                                                                                                                \
+            [](std::size_t d){ return make_batches(d, etl_dmat(d, d), etl_dmat(d, d)); },                                                         \
+            [](batch<etl_dmat>& R, batch<etl_dmat>& A){                                                                                           \
+                for(std::size_t i = 0; i < R.size(); ++i){ R[i] = etl::transpose(A[i]); }                                                         \
+            });                                                                                                                                   \
+        EVB_TWO_PASS_NS("blaze-static",                                                                                                           \
+            [](std::size_t d){ return make_batches(d, blaze_fdmat<N>(0.0), blaze_fdmat<N>(0.0)); },                                               \
+            [](batch<blaze_fdmat<N>>& R, batch<blaze_fdmat<N>>& A){                                                                               \
+                for(std::size_t i = 0; i < R.size(); ++i){ R[i] = blaze::trans(A[i]); }                                                           \
+            });                                                                                                                                   \
+        EVB_TWO_PASS_NS("blaze-dyn",                                                                                                              \
+            [](std::size_t d){ return make_batches(d, blaze_dmat(d, d), blaze_dmat(d, d)); },                                                     \
+            [](batch<blaze_dmat>& R, batch<blaze_dmat>& A){                                                                                       \
+                for(std::size_t i = 0; i < R.size(); ++i){ R[i] = blaze::trans(A[i]); }                                                           \
+            });                                                                                                                                   \
+        EVB_TWO_PASS_NS("eigen-fixed",                                                                                                            \
+            [](std::size_t d){ return make_batches(d, eigen_fdmat<N>::Zero().eval(), eigen_fdmat<N>::Zero().eval()); },                           \
+            [](batch<eigen_fdmat<N>>& R, batch<eigen_fdmat<N>>& A){                                                                               \
+                for(std::size_t i = 0; i < R.size(); ++i){ R[i] = A[i].transpose(); }                                                             \
+            });                                                                                                                                   \
+        EVB_TWO_PASS_NS("eigen-dyn",                                                                                                              \
+            [](std::size_t d){ return make_batches(d, eigen_dmat(d, d), eigen_dmat(d, d)); },                                                     \
+            [](batch<eigen_dmat>& R, batch<eigen_dmat>& A){                                                                                       \
+                for(std::size_t i = 0; i < R.size(); ++i){ R[i] = A[i].transpose(); }                                                             \
+            });                                                                                                                                   \
+    }
+
+// The inverse is counted as 2 * N^3 FLOPs, like a LU-based inversion
+#define FIXED_INVERSE_SECTION(N)                                                                                                                  \
+    EVB_SECTION_P("R = inv(A) (" #N "x" #N ")", VALUES_POLICY(N))                                                                                 \
+        EVB_COST(double,                                                                                                                          \
+            [](std::size_t d){ return 2.0 * d * d * d * batch_of(d); },                                                                           \
+            [](std::size_t d){ return 2.0 * 8 * d * d * batch_of(d); });                                                                          \
+                                                                                                                                                  \
+        EVB_ITEMS("ops", [](std::size_t d){ return 1.0 * batch_of(d); });                                                                         \
+                                                                                                                                                  \
+        EVB_OWN_DATA();                                                                                                                           \
+                                                                                                                                                  \
+        EVB_TWO_PASS_NS("etl-fast",                                                                                                               \
+            [](std::size_t d){ etl_fdmat<N> A; return make_batches(d, etl_fdmat<N>(0.0), make_invertible(A, d)); },                               \
+            [](batch<etl_fdmat<N>>& R, batch<etl_fdmat<N>>& A){                                                                                   \
+                for(std::size_t i = 0; i < R.size(); ++i){ R[i] = etl::inv(A[i]); }                                                               \
+            });                                                                                                                                   \
+        EVB_TWO_PASS_NS("etl-dyn",                                                                                                                \
+            [](std::size_t d){ etl_dmat A(d, d); return make_batches(d, etl_dmat(d, d), make_invertible(A, d)); },                                \
+            [](batch<etl_dmat>& R, batch<etl_dmat>& A){                                                                                           \
+                for(std::size_t i = 0; i < R.size(); ++i){ R[i] = etl::inv(A[i]); }                                                               \
+            });                                                                                                                                   \
+        EVB_TWO_PASS_NS("blaze-static",                                                                                                           \
+            [](std::size_t d){ blaze_fdmat<N> A; return make_batches(d, blaze_fdmat<N>(0.0), make_invertible(A, d)); },                           \
+            [](batch<blaze_fdmat<N>>& R, batch<blaze_fdmat<N>>& A){                                                                               \
+                for(std::size_t i = 0; i < R.size(); ++i){ R[i] = blaze::inv(A[i]); }                                                             \
+            });                                                                                                                                   \
+        EVB_TWO_PASS_NS("blaze-dyn",                                                                                                              \
+            [](std::size_t d){ blaze_dmat A(d, d); return make_batches(d, blaze_dmat(d, d), make_invertible(A, d)); },                            \
+            [](batch<blaze_dmat>& R, batch<blaze_dmat>& A){                                                                                       \
+                for(std::size_t i = 0; i < R.size(); ++i){ R[i] = blaze::inv(A[i]); }                                                             \
+            });                                                                                                                                   \
+        EVB_TWO_PASS_NS("eigen-fixed",                                                                                                            \
+            [](std::size_t d){ eigen_fdmat<N> A; return make_batches(d, eigen_fdmat<N>::Zero().eval(), make_invertible(A, d)); },                 \
+            [](batch<eigen_fdmat<N>>& R, batch<eigen_fdmat<N>>& A){                                                                               \
+                for(std::size_t i = 0; i < R.size(); ++i){ R[i] = A[i].inverse(); }                                                               \
+            });                                                                                                                                   \
+        EVB_TWO_PASS_NS("eigen-dyn",                                                                                                              \
+            [](std::size_t d){ eigen_dmat A(d, d); return make_batches(d, eigen_dmat(d, d), make_invertible(A, d)); },                            \
+            [](batch<eigen_dmat>& R, batch<eigen_dmat>& A){                                                                                       \
+                for(std::size_t i = 0; i < R.size(); ++i){ R[i] = A[i].inverse(); }                                                               \
+            });                                                                                                                                   \
+    }
+
+FIXED_MIX_SECTION(4)
+FIXED_MIX_SECTION(8)
+FIXED_MIX_SECTION(16)
+FIXED_MIX_SECTION(32)
+
+FIXED_GEMV_SECTION(4)
+FIXED_GEMV_SECTION(8)
+FIXED_GEMV_SECTION(16)
+FIXED_GEMV_SECTION(32)
+
+FIXED_GEMM_SECTION(4)
+FIXED_GEMM_SECTION(8)
+FIXED_GEMM_SECTION(16)
+FIXED_GEMM_SECTION(32)
+
+FIXED_TRANSPOSE_SECTION(4)
+FIXED_TRANSPOSE_SECTION(8)
+FIXED_TRANSPOSE_SECTION(16)
+FIXED_TRANSPOSE_SECTION(32)
+
+FIXED_INVERSE_SECTION(4)
+FIXED_INVERSE_SECTION(8)
+FIXED_INVERSE_SECTION(16)
+FIXED_INVERSE_SECTION(32)
+
+} //end of anonymous namespace
@@ -0,0 +1,148 @@
+#define CPM_LIB
+#include "benchmark.hpp"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "evb/data.hpp"
+
+// Transcendental and activation functions over large vectors. Besides the
+// throughput, the report gives the maximum and mean error of each library in
+// ULP, against a long double reference, computed once per point on the
+// same inputs as the measure.
+
+namespace {
+
+using math_policy = VALUES_POLICY(1000, 10000, 100000, 1000000, 4000000);
+
+using reference_t = std::vector<long double>;
+
+// The error of value in units of the last place of T, around the reference
+template<typename T>
+double ulp_error(T value, long double reference){
+    T exact = std::abs(static_cast<T>(reference));
+    T ulp   = std::nextafter(exact, std::numeric_limits<T>::infinity()) - exact;
+
+    return static_cast<double>(std::abs(static_cast<long double>(value) - reference) / ulp);
+}
+
+template<typename V>
+reference_t values(const V& a){
+    reference_t x(a.size());
+
+    for(std::size_t i = 0; i < x.size(); ++i){
+        x[i] = a[i];
+    }
+
+    return x;
+}
+
+// Make a reference from a scalar function
+template<typename F>
+auto elementwise(F f){
+    return [f](reference_t x){
+        for(auto& v : x){
+            v = f(v);
+        }
+
+        return x;
+    };
+}
+
+reference_t softmax_reference(reference_t x){
+    long double sum = 0.0;
+
+    for(auto& v : x){
+        v = std::exp(v);
+        sum += v;
+    }
+
+    for(auto& v : x){
+        v /= sum;
+    }
+
+    return x;
+}
+
+template<typename V>
+void tag_accuracy(const V& r, const reference_t& reference){
+    using value_type = typename std::decay<decltype(r[0])>::type;
+
+    double max = 0.0;
+    double sum = 0.0;
+
+    for(std::size_t i = 0; i < reference.size(); ++i){
+        double error = ulp_error<value_type>(r[i], reference[i]);
+
+        max = std::max(max, error);
+        sum += error;
+    }
+
+    evb::tag("ULP max", evb::format_double(max));
+    evb::tag("ULP mean", evb::format_double(sum / reference.size(), "%.3f"));
+}
+
+// Fill the input, run the kernel once to measure its accuracy and return the operands
+template<typename V, typename Kernel, typename Reference>
+std::tuple<V, V> math_init(std::size_t d, double low, double high, Kernel kernel, Reference reference){
+    V r(d);
+    V a(d);
+
+    evb::fill_uniform(a, low, high, evb::get_config().seed + 1);
+
+    kernel(r, a);
+    tag_accuracy(r, reference(values(a)));
+
+    return std::make_tuple(std::move(r), std::move(a));
+}
+
+#define MATH_SECTION(NAME, T, LOW, HIGH, REFERENCE, ETL, BLAZE, EIGEN)                                                                                                  \
+    EVB_SECTION_P(NAME, math_policy)                                                                                                                                     \
+        EVB_COST(T,                                                                                                                                                      \
+            [](std::size_t){ return 0.0; },                                                                                                                              \
+            [](std::size_t d){ return 2.0 * sizeof(T) * d; });                                                                                                           \
+                                                                                                                                                                         \
+        EVB_OWN_DATA();                                                                                                                                                  \
+                                                                                                                                                                         \
+        EVB_ITEMS("elements", [](std::size_t d){ return 1.0 * d; });                                                                                                     \
+                                                                                                                                                                         \
+        EVB_TWO_PASS_NS("etl",                                                                                                                                           \
+            [](std::size_t d){ return math_init<etl_dyn_vector<T>>(d, LOW, HIGH, [](etl_dyn_vector<T>& r, etl_dyn_vector<T>& a){ ETL; }, REFERENCE); },                  \
+            [](etl_dyn_vector<T>& r, etl_dyn_vector<T>& a){ ETL; });                                                                                                     \
+        EVB_TWO_PASS_NS("blaze",                                                                                                                                         \
+            [](std::size_t d){ return math_init<blaze_dyn_vector<T>>(d, LOW, HIGH, [](blaze_dyn_vector<T>& r, blaze_dyn_vector<T>& a){ BLAZE; }, REFERENCE); },          \
+            [](blaze_dyn_vector<T>& r, blaze_dyn_vector<T>& a){ BLAZE; });                                                                                               \
+        EVB_TWO_PASS_NS("eigen",                                                                                                                                         \
+            [](std::size_t d){ return math_init<eigen_dyn_vector<T>>(d, LOW, HIGH, [](eigen_dyn_vector<T>& r, eigen_dyn_vector<T>& a){ EIGEN; }, REFERENCE); },          \
+            [](eigen_dyn_vector<T>& r, eigen_dyn_vector<T>& a){ EIGEN; });                                                                                               \
+    }
+
+// Blaze has no sigmoid, it is computed with a (non-vectorized) custom operation
+#define BLAZE_SIGMOID(T) r = blaze::map(a, [](T x){ return T(1) / (T(1) + std::exp(-x)); })
+
+// Eigen has no softmax, it is computed in two passes
+#define EIGEN_SOFTMAX r.array() = a.array().exp(); r /= r.sum()
+
+MATH_SECTION("r = exp(a) (s)", float, -10.0, 10.0, elementwise([](long double x){ return std::exp(x); }), r = exp(a), r = exp(a), r.array() = a.array().exp())
+MATH_SECTION("r = exp(a) (d)", double, -10.0, 10.0, elementwise([](long double x){ return std::exp(x); }), r = exp(a), r = exp(a), r.array() = a.array().exp())
+
+MATH_SECTION("r = log(a) (s)", float, 0.01, 100.0, elementwise([](long double x){ return std::log(x); }), r = log(a), r = log(a), r.array() = a.array().log())
+MATH_SECTION("r = log(a) (d)", double, 0.01, 100.0, elementwise([](long double x){ return std::log(x); }), r = log(a), r = log(a), r.array() = a.array().log())
+
+MATH_SECTION("r = tanh(a) (s)", float, -5.0, 5.0, elementwise([](long double x){ return std::tanh(x); }), r = tanh(a), r = tanh(a), r.array() = a.array().tanh())
+MATH_SECTION("r = tanh(a) (d)", double, -5.0, 5.0, elementwise([](long double x){ return std::tanh(x); }), r = tanh(a), r = tanh(a), r.array() = a.array().tanh())
+
+MATH_SECTION("r = sigmoid(a) (s)", float, -10.0, 10.0, elementwise([](long double x){ return 1.0L / (1.0L + std::exp(-x)); }), r = etl::sigmoid(a), BLAZE_SIGMOID(float), r.array() = (float(1) + (-a.array()).exp()).inverse())
+MATH_SECTION("r = sigmoid(a) (d)", double, -10.0, 10.0, elementwise([](long double x){ return 1.0L / (1.0L + std::exp(-x)); }), r = etl::sigmoid(a), BLAZE_SIGMOID(double), r.array() = (double(1) + (-a.array()).exp()).inverse())
+
+MATH_SECTION("r = softmax(a) (s)", float, -5.0, 5.0, softmax_reference, r = etl::softmax(a), r = softmax(a), EIGEN_SOFTMAX)
+MATH_SECTION("r = softmax(a) (d)", double, -5.0, 5.0, softmax_reference, r = etl::softmax(a), r = softmax(a), EIGEN_SOFTMAX)
+
+MATH_SECTION("r = sqrt(a) (s)", float, 0.01, 100.0, elementwise([](long double x){ return std::sqrt(x); }), r = sqrt(a), r = sqrt(a), r.array() = a.array().sqrt())
+MATH_SECTION("r = sqrt(a) (d)", double, 0.01, 100.0, elementwise([](long double x){ return std::sqrt(x); }), r = sqrt(a), r = sqrt(a), r.array() = a.array().sqrt())
+
+MATH_SECTION("r = 1 / sqrt(a) (s)", float, 0.01, 100.0, elementwise([](long double x){ return 1.0L / std::sqrt(x); }), r = etl::invsqrt(a), r = invsqrt(a), r.array() = a.array().rsqrt())
+MATH_SECTION("r = 1 / sqrt(a) (d)", double, 0.01, 100.0, elementwise([](long double x){ return 1.0L / std::sqrt(x); }), r = etl::invsqrt(a), r = invsqrt(a), r.array() = a.array().rsqrt())
+
+} //end of anonymous namespace
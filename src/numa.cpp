@@ -0,0 +1,17 @@
+#include "evb/numa.hpp"
+
+// The process is restricted to the CPUs of EVB_CPUS before the static
+// initialization of the benchmark and of the libraries, which may already
+// create threads, like the thread pool of ETL. The constructors with a
+// priority run before the ones of the C++ static objects.
+
+namespace {
+
+#if defined(__GNUC__)
+__attribute__((constructor(101)))
+#endif
+void restrict_process(){
+    evb::restrict_threads();
+}
+
+} //end of anonymous namespace
@@ -0,0 +1,289 @@
+#define CPM_LIB
+#include "benchmark.hpp"
+
+#include <cmath>
+#include <tuple>
+#include <vector>
+
+#include "evb/data.hpp"
+
+// Reductions of vectors and of the rows and columns of tall matrices, in
+// single and double precision. The cost model only counts the bytes of the
+// input, read once, so that the GB/s of each library show how well its
+// reductions are vectorized and split over several accumulators. The scalar
+// results are kept with evb::keep, without any store.
+//
+// The sums are also computed with compensated algorithms, the error of each
+// variant relative to a long double sum of the same values is reported.
+
+namespace {
+
+using reduce_policy = VALUES_POLICY(1000, 10000, 100000, 1000000, 10000000);
+
+// Pairs of (rows, columns)
+using axis_policy = NARY_POLICY(
+    VALUES_POLICY(1000, 10000, 100000, 500000, 1000, 10000, 100000),
+    VALUES_POLICY(16, 16, 16, 16, 256, 256, 64));
+
+// The number of elements summed by the library at the leaves of the pairwise sums
+constexpr std::size_t pairwise_block = 1024;
+
+// Sum [first, first + n) by halves, down to the blocks summed by the library
+template<typename T, typename Leaf>
+T pairwise(std::size_t first, std::size_t n, Leaf leaf){
+    if(n <= pairwise_block){
+        return leaf(first, n);
+    }
+
+    std::size_t half = ((n / pairwise_block + 1) / 2) * pairwise_block;
+
+    return pairwise<T>(first, half, leaf) + pairwise<T>(first + half, n - half, leaf);
+}
+
+template<typename T>
+T etl_pairwise(const etl_dyn_vector<T>& a){
+    return pairwise<T>(0, etl::size(a), [&a](std::size_t first, std::size_t n){ return etl::sum(etl::slice(a, first, first + n)); });
+}
+
+template<typename T>
+T blaze_pairwise(const blaze_dyn_vector<T>& a){
+    return pairwise<T>(0, a.size(), [&a](std::size_t first, std::size_t n){ return blaze::sum(blaze::subvector(a, first, n)); });
+}
+
+template<typename T>
+T eigen_pairwise(const eigen_dyn_vector<T>& a){
+    return pairwise<T>(0, a.size(), [&a](std::size_t first, std::size_t n){ return a.segment(first, n).sum(); });
+}
+
+// Kahan summation, with four independent accumulators to hide the latency of
+// the compensation. No library provides it. It is removed by -ffast-math.
+template<typename T>
+T kahan(const std::vector<T>& a){
+    T sum[4]          = {};
+    T compensation[4] = {};
+
+    const std::size_t n = a.size();
+
+    std::size_t i = 0;
+
+    for(; i + 3 < n; i += 4){
+        for(std::size_t k = 0; k < 4; ++k){
+            T y             = a[i + k] - compensation[k];
+            T t             = sum[k] + y;
+            compensation[k] = (t - sum[k]) - y;
+            sum[k]          = t;
+        }
+    }
+
+    for(; i < n; ++i){
+        T y             = a[i] - compensation[0];
+        T t             = sum[0] + y;
+        compensation[0] = (t - sum[0]) - y;
+        sum[0]          = t;
+    }
+
+    return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+}
+
+// A single accumulator, in order, as written by hand
+template<typename T>
+T loop(const std::vector<T>& a){
+    T sum = 0;
+
+    for(auto v : a){
+        sum += v;
+    }
+
+    return sum;
+}
+
+// Fill the input, sum it once to measure the error of the kernel and return the operands
+template<typename V, typename Kernel>
+std::tuple<V> sum_init(std::size_t d, Kernel kernel){
+    V a(d);
+
+    evb::fill_uniform(a, 0.0, 1.0, evb::get_config().seed);
+
+    long double reference = 0.0;
+
+    for(std::size_t i = 0; i < d; ++i){
+        reference += a[i];
+    }
+
+    long double sum = kernel(a);
+
+    evb::tag("rel error", evb::format_double(static_cast<double>(std::abs(sum - reference) / reference), "%.2e"));
+
+    return std::make_tuple(std::move(a));
+}
+
+// The variance, in two passes, for the libraries without one
+template<typename T>
+T etl_var(const etl_dyn_vector<T>& a){
+    T m = etl::mean(a);
+    return etl::sum((a - m) >> (a - m)) / T(etl::size(a) - 1);
+}
+
+template<typename T>
+T eigen_var(const eigen_dyn_vector<T>& a){
+    T m = a.mean();
+    return (a.array() - m).square().sum() / T(a.size() - 1);
+}
+
+template<typename T>
+Eigen::Index eigen_argmax(const eigen_dyn_vector<T>& a){
+    Eigen::Index i;
+    a.maxCoeff(&i);
+    return i;
+}
+
+// The variances of the columns, with the means of the two passes
+// preallocated next to them. Only the variances are filled and validated.
+template<typename V>
+struct var_columns_result {
+    V r; ///< The variance of each column
+    V m; ///< The mean of each column
+
+    explicit var_columns_result(std::size_t n) : r(n), m(n) {}
+
+    auto operands(){
+        return std::tie(r);
+    }
+};
+
+template<typename T>
+void etl_var_columns(var_columns_result<etl_dyn_vector<T>>& v, const etl_dyn_matrix<T>& A){
+    const std::size_t n = etl::rows(A);
+
+    v.m = etl::mean_l(A);
+    v.r = etl::sum_l((A - etl::rep_l(v.m, n)) >> (A - etl::rep_l(v.m, n))) / T(n - 1);
+}
+
+template<typename T>
+void eigen_var_columns(var_columns_result<eigen_dyn_vector_row<T>>& v, const eigen_dyn_matrix_rm<T>& A){
+    v.m = A.colwise().mean();
+    v.r = (A.rowwise() - v.m).array().square().colwise().sum() / T(A.rows() - 1);
+}
+
+#define SUM_SECTION(NAME, T)                                                                                                  \
+    EVB_SECTION_P(NAME, reduce_policy)                                                                                        \
+        EVB_COST(T,                                                                                                           \
+            [](std::size_t d){ return 1.0 * d; },                                                                             \
+            [](std::size_t d){ return 1.0 * sizeof(T) * d; });                                                                \
+                                                                                                                              \
+        EVB_OWN_DATA();                                                                                                       \
+                                                                                                                              \
+        EVB_TWO_PASS_NS("etl",                                                                                                \
+            [](std::size_t d){ return sum_init<etl_dyn_vector<T>>(d, [](etl_dyn_vector<T>& a){ return etl::sum(a); }); },    \
+            [](etl_dyn_vector<T>& a){ evb::keep(etl::sum(a)); });                                                             \
+        EVB_TWO_PASS_NS("etl-pairwise",                                                                                       \
+            [](std::size_t d){ return sum_init<etl_dyn_vector<T>>(d, etl_pairwise<T>); },                                     \
+            [](etl_dyn_vector<T>& a){ evb::keep(etl_pairwise<T>(a)); });                                                      \
+        EVB_TWO_PASS_NS("blaze",                                                                                              \
+            [](std::size_t d){ return sum_init<blaze_dyn_vector<T>>(d, [](blaze_dyn_vector<T>& a){ return blaze::sum(a); }); }, \
+            [](blaze_dyn_vector<T>& a){ evb::keep(blaze::sum(a)); });                                                         \
+        EVB_TWO_PASS_NS("blaze-pairwise",                                                                                     \
+            [](std::size_t d){ return sum_init<blaze_dyn_vector<T>>(d, blaze_pairwise<T>); },                                \
+            [](blaze_dyn_vector<T>& a){ evb::keep(blaze_pairwise<T>(a)); });                                                  \
+        EVB_TWO_PASS_NS("eigen",                                                                                              \
+            [](std::size_t d){ return sum_init<eigen_dyn_vector<T>>(d, [](eigen_dyn_vector<T>& a){ return a.sum(); }); },    \
+            [](eigen_dyn_vector<T>& a){ evb::keep(a.sum()); });                                                               \
+        EVB_TWO_PASS_NS("eigen-pairwise",                                                                                     \
+            [](std::size_t d){ return sum_init<eigen_dyn_vector<T>>(d, eigen_pairwise<T>); },                                 \
+            [](eigen_dyn_vector<T>& a){ evb::keep(eigen_pairwise<T>(a)); });                                                  \
+        EVB_TWO_PASS_NS("kahan",                                                                                              \
+            [](std::size_t d){ return sum_init<std::vector<T>>(d, kahan<T>); },                                               \
+            [](std::vector<T>& a){ evb::keep(kahan<T>(a)); });                                                                \
+        EVB_TWO_PASS_NS("loop",                                                                                               \
+            [](std::size_t d){ return sum_init<std::vector<T>>(d, loop<T>); },                                                \
+            [](std::vector<T>& a){ evb::keep(loop<T>(a)); });                                                                 \
+    }
+
+#define REDUCE_SECTION(NAME, T, ETL, BLAZE, EIGEN)                                           \
+    EVB_SECTION_P(NAME, reduce_policy)                                                       \
+        EVB_COST(T,                                                                          \
+            [](std::size_t d){ return 1.0 * d; },                                            \
+            [](std::size_t d){ return 1.0 * sizeof(T) * d; });                               \
+                                                                                             \
+        EVB_TWO_PASS_NS("etl",                                                               \
+            [](std::size_t d){ return std::make_tuple(etl_dyn_vector<T>(d)); },              \
+            [](etl_dyn_vector<T>& a){ evb::keep(ETL); });                                    \
+        EVB_TWO_PASS_NS("blaze",                                                             \
+            [](std::size_t d){ return std::make_tuple(blaze_dyn_vector<T>(d)); },            \
+            [](blaze_dyn_vector<T>& a){ evb::keep(BLAZE); });                                \
+        EVB_TWO_PASS_NS("eigen",                                                             \
+            [](std::size_t d){ return std::make_tuple(eigen_dyn_vector<T>(d)); },            \
+            [](eigen_dyn_vector<T>& a){ evb::keep(EIGEN); });                                \
+    }
+
+// The reduction of the rows (RESULTS is rows) or of the columns (RESULTS is
+// columns) of A into r. The matrices are row-major in all the libraries.
+#define AXIS_SECTION(NAME, T, RESULTS, BLAZE_R, EIGEN_R, ETL, BLAZE, EIGEN)                                                         \
+    EVB_SECTION_P(NAME, axis_policy)                                                                                                \
+        EVB_COST(T,                                                                                                                 \
+            [](std::size_t rows, std::size_t columns){ return 1.0 * rows * columns; },                                              \
+            [](std::size_t rows, std::size_t columns){ return 1.0 * sizeof(T) * rows * columns; });                                 \
+                                                                                                                                    \
+        EVB_TWO_PASS_NS("etl",                                                                                                      \
+            [](std::size_t rows, std::size_t columns){ return std::make_tuple(etl_dyn_matrix<T>(rows, columns), etl_dyn_vector<T>(RESULTS)); }, \
+            [](etl_dyn_matrix<T>& A, etl_dyn_vector<T>& r){ ETL; });                                                                \
+        EVB_TWO_PASS_NS("blaze",                                                                                                    \
+            [](std::size_t rows, std::size_t columns){ return std::make_tuple(blaze_dyn_matrix<T>(rows, columns), BLAZE_R(RESULTS)); },      \
+            [](blaze_dyn_matrix<T>& A, BLAZE_R& r){ BLAZE; });                                                                      \
+        EVB_TWO_PASS_NS("eigen",                                                                                                    \
+            [](std::size_t rows, std::size_t columns){ return std::make_tuple(eigen_dyn_matrix_rm<T>(rows, columns), EIGEN_R(RESULTS)); },   \
+            [](eigen_dyn_matrix_rm<T>& A, EIGEN_R& r){ EIGEN; });                                                                   \
+    }
+
+// The variance of the columns of A, in two passes in every library
+#define VAR_COLUMNS_SECTION(NAME, T)                                                                                                \
+    EVB_SECTION_P(NAME, axis_policy)                                                                                                \
+        EVB_COST(T,                                                                                                                 \
+            [](std::size_t rows, std::size_t columns){ return 1.0 * rows * columns; },                                              \
+            [](std::size_t rows, std::size_t columns){ return 1.0 * sizeof(T) * rows * columns; });                                 \
+                                                                                                                                    \
+        EVB_TWO_PASS_NS("etl",                                                                                                      \
+            [](std::size_t rows, std::size_t columns){ return std::make_tuple(etl_dyn_matrix<T>(rows, columns), var_columns_result<etl_dyn_vector<T>>(columns)); }, \
+            [](etl_dyn_matrix<T>& A, var_columns_result<etl_dyn_vector<T>>& r){ etl_var_columns(r, A); });                          \
+        EVB_TWO_PASS_NS("blaze",                                                                                                    \
+            [](std::size_t rows, std::size_t columns){ return std::make_tuple(blaze_dyn_matrix<T>(rows, columns), blaze_dyn_vector_row<T>(columns)); }, \
+            [](blaze_dyn_matrix<T>& A, blaze_dyn_vector_row<T>& r){ r = blaze::var<blaze::columnwise>(A); });                       \
+        EVB_TWO_PASS_NS("eigen",                                                                                                    \
+            [](std::size_t rows, std::size_t columns){ return std::make_tuple(eigen_dyn_matrix_rm<T>(rows, columns), var_columns_result<eigen_dyn_vector_row<T>>(columns)); }, \
+            [](eigen_dyn_matrix_rm<T>& A, var_columns_result<eigen_dyn_vector_row<T>>& r){ eigen_var_columns(r, A); });             \
+    }
+
+SUM_SECTION("sum(a) (s)", float)
+SUM_SECTION("sum(a) (d)", double)
+
+REDUCE_SECTION("norm(a) (s)", float, etl::norm(a), blaze::norm(a), a.norm())
+REDUCE_SECTION("norm(a) (d)", double, etl::norm(a), blaze::norm(a), a.norm())
+
+REDUCE_SECTION("min(a) (s)", float, etl::min(a), blaze::min(a), a.minCoeff())
+REDUCE_SECTION("min(a) (d)", double, etl::min(a), blaze::min(a), a.minCoeff())
+
+REDUCE_SECTION("max(a) (s)", float, etl::max(a), blaze::max(a), a.maxCoeff())
+REDUCE_SECTION("max(a) (d)", double, etl::max(a), blaze::max(a), a.maxCoeff())
+
+REDUCE_SECTION("argmax(a) (s)", float, etl::max_index(a), blaze::argmax(a), eigen_argmax(a))
+REDUCE_SECTION("argmax(a) (d)", double, etl::max_index(a), blaze::argmax(a), eigen_argmax(a))
+
+REDUCE_SECTION("mean(a) (s)", float, etl::mean(a), blaze::mean(a), a.mean())
+REDUCE_SECTION("mean(a) (d)", double, etl::mean(a), blaze::mean(a), a.mean())
+
+REDUCE_SECTION("var(a) (s)", float, etl_var(a), blaze::var(a), eigen_var(a))
+REDUCE_SECTION("var(a) (d)", double, etl_var(a), blaze::var(a), eigen_var(a))
+
+AXIS_SECTION("r = sum(A, rows) (s)", float, rows, blaze_dyn_vector<float>, eigen_dyn_vector<float>, r = etl::sum_r(A), r = blaze::sum<blaze::rowwise>(A), r = A.rowwise().sum())
+AXIS_SECTION("r = sum(A, rows) (d)", double, rows, blaze_dyn_vector<double>, eigen_dyn_vector<double>, r = etl::sum_r(A), r = blaze::sum<blaze::rowwise>(A), r = A.rowwise().sum())
+
+AXIS_SECTION("r = sum(A, columns) (s)", float, columns, blaze_dyn_vector_row<float>, eigen_dyn_vector_row<float>, r = etl::sum_l(A), r = blaze::sum<blaze::columnwise>(A), r = A.colwise().sum())
+AXIS_SECTION("r = sum(A, columns) (d)", double, columns, blaze_dyn_vector_row<double>, eigen_dyn_vector_row<double>, r = etl::sum_l(A), r = blaze::sum<blaze::columnwise>(A), r = A.colwise().sum())
+
+AXIS_SECTION("r = mean(A, columns) (s)", float, columns, blaze_dyn_vector_row<float>, eigen_dyn_vector_row<float>, r = etl::mean_l(A), r = blaze::mean<blaze::columnwise>(A), r = A.colwise().mean())
+AXIS_SECTION("r = mean(A, columns) (d)", double, columns, blaze_dyn_vector_row<double>, eigen_dyn_vector_row<double>, r = etl::mean_l(A), r = blaze::mean<blaze::columnwise>(A), r = A.colwise().mean())
+
+VAR_COLUMNS_SECTION("r = var(A, columns) (s)", float)
+VAR_COLUMNS_SECTION("r = var(A, columns) (d)", double)
+
+} //end of anonymous namespace
@@ -1,171 +1,162 @@
-#include "cblas.h"
-
-#include <eigen3/Eigen/Dense>
-#include "etl/etl.hpp"
-#include <blaze/Math.h>
-
-#define CPM_NO_RANDOM_INITIALIZATION
-#define CPM_NO_RANDOMIZATION
-#define CPM_AUTO_STEPS
-#define CPM_STEP_ESTIMATION_MIN 0.025   //Run during 0.025 seconds for estimating steps
-#define CPM_RUNTIME_TARGET 0.9          //Run each test during 0.9 seconds
-
 #define CPM_BENCHMARK "ETL/Blaze/Eigen Benchmark"
-#include "cpm/cpm.hpp"
+#include "benchmark.hpp"
 
 namespace {
 
-template<typename T>
-using etl_dyn_vector = etl::dyn_vector<T>;
-
-template<typename T>
-using blaze_dyn_vector = blaze::DynamicVector<T>;
-
-template<typename T>
-using blaze_dyn_vector_row = blaze::DynamicVector<T,blaze::rowVector>;
-
-template<typename T>
-using etl_dyn_matrix = etl::dyn_matrix<T>;
+// r *= 3.3 and c *= dot(a, b) scale their operand in place at each call,
+// with the data of EVB_DATA they would overflow to inf after a few hundred
+// calls. r is kept at zero, and b is scaled so that dot(a, b) is 1.
 
-template<typename T>
-using blaze_dyn_matrix = blaze::DynamicMatrix<T>;
+// Fill the operands like the harness does, for the sections with their own data
+template<typename... V>
+void fill_own_data(V&... v){
+    auto& config     = evb::get_config();
+    std::size_t seed = config.seed;
 
-template<typename T>
-using eigen_dyn_vector = Eigen::Matrix<T, Eigen::Dynamic, 1>;
-
-template<typename T>
-using eigen_dyn_matrix = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>;
-
-using etl_dvec = etl_dyn_vector<double>;
-using blaze_dvec = blaze_dyn_vector<double>;
-using blaze_dvec_row = blaze_dyn_vector_row<double>;
-using eigen_dvec = eigen_dyn_vector<double>;
-
-using etl_dmat = etl_dyn_matrix<double>;
-using blaze_dmat = blaze_dyn_matrix<double>;
-using eigen_dmat = eigen_dyn_matrix<double>;
+    int filled[] = {0, (evb::fill(v, config.data, seed++), 0)...};
+    (void)filled;
+}
 
-using etl_svec = etl_dyn_vector<float>;
-using blaze_svec = blaze_dyn_vector<float>;
-using eigen_svec = eigen_dyn_vector<float>;
+// Scale b so that dot(a, b) is 1, unless it is 0
+template<typename V>
+void normalize_dot(const V& a, V& b){
+    const std::size_t n = a.size();
 
-using etl_smat = etl_dyn_matrix<float>;
-using blaze_smat = blaze_dyn_matrix<float>;
-using eigen_smat = eigen_dyn_matrix<float>;
+    long double dot = 0.0;
 
-CPM_SECTION_P("r = exp(a) (s)", VALUES_POLICY(1000, 10000, 100000, 500000, 1000000, 1500000, 2000000, 2500000, 3000000, 3500000, 4000000))
-    CPM_TWO_PASS_NS("etl",
-        [](std::size_t d){ return std::make_tuple(etl_svec(d), etl_svec(d)); },
-        [](etl_svec& r, etl_svec& a){ r = exp(a); }
-        );
+    for(std::size_t i = 0; i < n; ++i){
+        dot += a[i] * b[i];
+    }
 
-    CPM_TWO_PASS_NS("blaze",
-        [](std::size_t d){ return std::make_tuple(blaze_svec(d), blaze_svec(d)); },
-        [](blaze_svec& r, blaze_svec& a){ r = exp(a); }
-        );
-
-    // Eigen?
+    if(dot != 0.0){
+        for(std::size_t i = 0; i < n; ++i){
+            b[i] = static_cast<double>(b[i] / dot);
+        }
+    }
 }
 
-CPM_SECTION_P("r = exp(a) (d)", VALUES_POLICY(10000, 100000, 500000, 1000000, 1500000, 2000000, 2500000, 3000000, 3500000, 4000000))
-    CPM_TWO_PASS_NS("etl",
-        [](std::size_t d){ return std::make_tuple(etl_dvec(d), etl_dvec(d)); },
-        [](etl_dvec& r, etl_dvec& a){ r = exp(a); }
-        );
-
-    CPM_TWO_PASS_NS("blaze",
-        [](std::size_t d){ return std::make_tuple(blaze_dvec(d), blaze_dvec(d)); },
-        [](blaze_dvec& r, blaze_dvec& a){ r = exp(a); }
-        );
+EVB_SECTION_P("r = (a + 0.0 * a) * 1.0", VALUES_POLICY(500000, 1000000, 1500000, 2000000, 2500000, 3000000, 3500000, 4000000, 4500000, 5000000))
+    EVB_COST(double,
+        [](std::size_t d){ return 3.0 * d; },
+        [](std::size_t d){ return 2.0 * 8 * d; });
 
-    // Eigen?
-}
-
-CPM_SECTION_P("r = (a + 0.0 * a) * 1.0", VALUES_POLICY(500000, 1000000, 1500000, 2000000, 2500000, 3000000, 3500000, 4000000, 4500000, 5000000))
-    CPM_TWO_PASS_NS("etl",
+    EVB_TWO_PASS_NS("etl",
         [](std::size_t d){ return std::make_tuple(etl_dvec(d), etl_dvec(d)); },
         [](etl_dvec& r, etl_dvec& a){ r = (a + 0.0 * a) * 1.0; }
         );
 
-    CPM_TWO_PASS_NS("etl_opt",
+    EVB_TWO_PASS_NS("etl_opt",
         [](std::size_t d){ return std::make_tuple(etl_dvec(d), etl_dvec(d)); },
         [](etl_dvec& r, etl_dvec& a){ r = opt((a + 0.0 * a) * 1.0); }
         );
 
-    CPM_TWO_PASS_NS("blaze",
+    EVB_TWO_PASS_NS("blaze",
         [](std::size_t d){ return std::make_tuple(blaze_dvec(d), blaze_dvec(d)); },
         [](blaze_dvec& r, blaze_dvec& a){ r = (a + 0.0 * a) * 1.0; }
         );
 
-    CPM_TWO_PASS_NS("eigen",
+    EVB_TWO_PASS_NS("eigen",
         [](std::size_t d){ return std::make_tuple(eigen_dvec(d), eigen_dvec(d)); },
         [](eigen_dvec& r, eigen_dvec& a){ r = (a + 0.0 * a) * 1.0; }
         );
 }
 
-CPM_SECTION_P("r *= 3.3", VALUES_POLICY(500000, 1000000, 1500000, 2000000, 2500000, 3000000, 3500000, 4000000, 4500000, 5000000))
-    CPM_TWO_PASS_NS("etl",
-        [](std::size_t d){ return std::make_tuple(etl_dvec(d)); },
+EVB_SECTION_P("r *= 3.3", VALUES_POLICY(500000, 1000000, 1500000, 2000000, 2500000, 3000000, 3500000, 4000000, 4500000, 5000000))
+    EVB_COST(double,
+        [](std::size_t d){ return 1.0 * d; },
+        [](std::size_t d){ return 2.0 * 8 * d; });
+
+    EVB_OWN_DATA();
+
+    EVB_TWO_PASS_NS("etl",
+        [](std::size_t d){ return std::make_tuple(etl_dvec(d, 0.0)); },
         [](etl_dvec& r){ r *= 3.3; }
         );
 
-    CPM_TWO_PASS_NS("blaze",
-        [](std::size_t d){ return std::make_tuple(blaze_dvec(d)); },
+    EVB_TWO_PASS_NS("blaze",
+        [](std::size_t d){ return std::make_tuple(blaze_dvec(d, 0.0)); },
         [](blaze_dvec& r){ r *= 3.3; }
         );
 
-    CPM_TWO_PASS_NS("eigen",
-        [](std::size_t d){ return std::make_tuple(eigen_dvec(d)); },
+    EVB_TWO_PASS_NS("eigen",
+        [](std::size_t d){ return std::make_tuple(eigen_dvec(eigen_dvec::Zero(d))); },
         [](eigen_dvec& r){ r *= 3.3; }
         );
 }
 
-CPM_SECTION_P("add_complex", VALUES_POLICY(500000, 1000000, 1500000, 2000000, 2500000, 3000000, 3500000, 4000000))
-    CPM_TWO_PASS_NS("etl",
+EVB_SECTION_P("add_complex", VALUES_POLICY(500000, 1000000, 1500000, 2000000, 2500000, 3000000, 3500000, 4000000))
+    EVB_COST(double,
+        [](std::size_t d){ return 8.0 * d; },
+        [](std::size_t d){ return 3.0 * 8 * d; });
+
+    EVB_TWO_PASS_NS("etl",
         [](std::size_t d){ return std::make_tuple(etl_dvec(d), etl_dvec(d), etl_dvec(d)); },
         [](etl_dvec& r, etl_dvec& a, etl_dvec& b){ r = a + b + a + b + a + a + b + a + a; }
         );
 
-    CPM_TWO_PASS_NS("blaze",
+    EVB_TWO_PASS_NS("blaze",
         [](std::size_t d){ return std::make_tuple(blaze_dvec(d), blaze_dvec(d), blaze_dvec(d)); },
         [](blaze_dvec& r, blaze_dvec& a, blaze_dvec& b){ r = a + b + a + b + a + a + b + a + a; }
         );
 
-    CPM_TWO_PASS_NS("eigen",
+    EVB_TWO_PASS_NS("eigen",
         [](std::size_t d){ return std::make_tuple(eigen_dvec(d), eigen_dvec(d), eigen_dvec(d)); },
         [](eigen_dvec& r, eigen_dvec& a, eigen_dvec& b){ r = a + b + a + b + a + a + b + a + a; }
         );
 }
 
-CPM_SECTION_P("mix", VALUES_POLICY(500000, 1000000, 1500000, 2000000, 2500000, 3000000, 3500000, 4000000))
-    CPM_TWO_PASS_NS("etl",
+EVB_SECTION_P("mix", VALUES_POLICY(500000, 1000000, 1500000, 2000000, 2500000, 3000000, 3500000, 4000000))
+    EVB_COST(double,
+        [](std::size_t d){ return 9.0 * d; },
+        [](std::size_t d){ return 3.0 * 8 * d; });
+
+    EVB_TWO_PASS_NS("etl",
         [](std::size_t d){ return std::make_tuple(etl_dvec(d), etl_dvec(d), etl_dvec(d)); },
         [](etl_dvec& r, etl_dvec& a, etl_dvec& b){ r = a + a * 5.9 + a + b - b / 2.3 - a + b * 1.1; }
         );
 
-    CPM_TWO_PASS_NS("blaze",
+    EVB_TWO_PASS_NS("blaze",
         [](std::size_t d){ return std::make_tuple(blaze_dvec(d), blaze_dvec(d), blaze_dvec(d)); },
         [](blaze_dvec& r, blaze_dvec& a, blaze_dvec& b){ r = a + a * 5.9 + a + b - b / 2.3 - a + b * 1.1; }
         );
 
-    CPM_TWO_PASS_NS("eigen",
+    EVB_TWO_PASS_NS("eigen",
         [](std::size_t d){ return std::make_tuple(eigen_dvec(d), eigen_dvec(d), eigen_dvec(d)); },
         [](eigen_dvec& r, eigen_dvec& a, eigen_dvec& b){ r = a + a * 5.9 + a + b - b / 2.3 - a + b * 1.1; }
         );
 }
 
-CPM_SECTION_P("mix_matrix", NARY_POLICY(VALUES_POLICY(100, 200, 300, 400, 500, 600, 700, 800, 900, 1000), VALUES_POLICY(100, 200, 300, 400, 500, 600, 700, 800, 900, 1000)))
-    CPM_TWO_PASS_NS("etl",
+EVB_SECTION_P("mix_matrix", NARY_POLICY(VALUES_POLICY(100, 200, 300, 400, 500, 600, 700, 800, 900, 1000), VALUES_POLICY(100, 200, 300, 400, 500, 600, 700, 800, 900, 1000)))
+    EVB_COST(double,
+        [](std::size_t d1, std::size_t d2){ return 9.0 * d1 * d2; },
+        [](std::size_t d1, std::size_t d2){ return 3.0 * 8 * d1 * d2; });
+
+    EVB_TWO_PASS_NS("etl-rm",
         [](std::size_t d1, std::size_t d2){ return std::make_tuple(etl_dmat(d1,d2), etl_dmat(d1,d2), etl_dmat(d1,d2)); },
         [](etl_dmat& R, etl_dmat& A, etl_dmat& B){ R = A + A * 5.9 + A + B - B / 2.3 - A + B * 1.1; }
         );
 
-    CPM_TWO_PASS_NS("blaze",
+    EVB_TWO_PASS_NS("etl-cm",
+        [](std::size_t d1, std::size_t d2){ return std::make_tuple(etl_dmat_cm(d1,d2), etl_dmat_cm(d1,d2), etl_dmat_cm(d1,d2)); },
+        [](etl_dmat_cm& R, etl_dmat_cm& A, etl_dmat_cm& B){ R = A + A * 5.9 + A + B - B / 2.3 - A + B * 1.1; }
+        );
+
+    EVB_TWO_PASS_NS("blaze-rm",
         [](std::size_t d1, std::size_t d2){ return std::make_tuple(blaze_dmat(d1,d2), blaze_dmat(d1,d2), blaze_dmat(d1,d2)); },
         [](blaze_dmat& R, blaze_dmat& A, blaze_dmat& B){ R = A + A * 5.9 + A + B - B / 2.3 - A + B * 1.1; }
         );
 
-    CPM_TWO_PASS_NS("eigen",
+    EVB_TWO_PASS_NS("blaze-cm",
+        [](std::size_t d1, std::size_t d2){ return std::make_tuple(blaze_dmat_cm(d1,d2), blaze_dmat_cm(d1,d2), blaze_dmat_cm(d1,d2)); },
+        [](blaze_dmat_cm& R, blaze_dmat_cm& A, blaze_dmat_cm& B){ R = A + A * 5.9 + A + B - B / 2.3 - A + B * 1.1; }
+        );
+
+    EVB_TWO_PASS_NS("eigen-rm",
+        [](std::size_t d1, std::size_t d2){ return std::make_tuple(eigen_dmat_rm(d1,d2), eigen_dmat_rm(d1,d2), eigen_dmat_rm(d1,d2)); },
+        [](eigen_dmat_rm& R, eigen_dmat_rm& A, eigen_dmat_rm& B){ R = A + A * 5.9 + A + B - B / 2.3 - A + B * 1.1; }
+        );
+
+    EVB_TWO_PASS_NS("eigen-cm",
         [](std::size_t d1, std::size_t d2){ return std::make_tuple(eigen_dmat(d1,d2), eigen_dmat(d1,d2), eigen_dmat(d1,d2)); },
         [](eigen_dmat& R, eigen_dmat& A, eigen_dmat& B){ R = A + A * 5.9 + A + B - B / 2.3 - A + B * 1.1; }
         );
@@ -173,118 +164,281 @@ CPM_SECTION_P("mix_matrix", NARY_POLICY(VALUES_POLICY(100, 200, 300, 400, 500, 6
 
 using vector_policy = VALUES_POLICY(100, 1000, 10000, 100000, 500000, 1000000, 2000000, 3000000, 4000000);
 
-CPM_SECTION_P("r = a + b (d)", vector_policy)
-    CPM_TWO_PASS_NS("etl",
+EVB_SECTION_P("r = a + b (d)", vector_policy)
+    EVB_COST(double,
+        [](std::size_t d){ return 1.0 * d; },
+        [](std::size_t d){ return 3.0 * 8 * d; });
+
+    EVB_TWO_PASS_NS("etl",
         [](std::size_t d){ return std::make_tuple(etl_dvec(d), etl_dvec(d), etl_dvec(d)); },
         [](etl_dvec& r, etl_dvec& a, etl_dvec& b){ r = a + b; }
         );
-    CPM_TWO_PASS_NS("blaze",
+    EVB_TWO_PASS_NS("blaze",
         [](std::size_t d){ return std::make_tuple(blaze_dvec(d), blaze_dvec(d), blaze_dvec(d)); },
         [](blaze_dvec& r, blaze_dvec& a, blaze_dvec& b){ r = a + b; }
         );
-    CPM_TWO_PASS_NS("eigen",
+    EVB_TWO_PASS_NS("eigen",
         [](std::size_t d){ return std::make_tuple(eigen_dvec(d), eigen_dvec(d), eigen_dvec(d)); },
         [](eigen_dvec& r, eigen_dvec& a, eigen_dvec& b){ r = a + b; }
         );
 }
 
-CPM_SECTION_P("r = a + b (s)", vector_policy)
-    CPM_TWO_PASS_NS("etl",
+EVB_SECTION_P("r = a + b (s)", vector_policy)
+    EVB_COST(float,
+        [](std::size_t d){ return 1.0 * d; },
+        [](std::size_t d){ return 3.0 * 4 * d; });
+
+    EVB_TWO_PASS_NS("etl",
         [](std::size_t d){ return std::make_tuple(etl_svec(d), etl_svec(d), etl_svec(d)); },
         [](etl_svec& r, etl_svec& a, etl_svec& b){ r = a + b; }
         );
-    CPM_TWO_PASS_NS("blaze",
+    EVB_TWO_PASS_NS("blaze",
         [](std::size_t d){ return std::make_tuple(blaze_svec(d), blaze_svec(d), blaze_svec(d)); },
         [](blaze_svec& r, blaze_svec& a, blaze_svec& b){ r = a + b; }
         );
-    CPM_TWO_PASS_NS("eigen",
+    EVB_TWO_PASS_NS("eigen",
         [](std::size_t d){ return std::make_tuple(eigen_svec(d), eigen_svec(d), eigen_svec(d)); },
         [](eigen_svec& r, eigen_svec& a, eigen_svec& b){ r = a + b; }
         );
 }
 
-CPM_SECTION_P("r = a + b + c", VALUES_POLICY(500000, 1000000, 1500000, 2000000, 2500000, 3000000, 3500000, 4000000))
-    CPM_TWO_PASS_NS("etl",
+EVB_SECTION_P("r = a + b + c", VALUES_POLICY(500000, 1000000, 1500000, 2000000, 2500000, 3000000, 3500000, 4000000))
+    EVB_COST(double,
+        [](std::size_t d){ return 2.0 * d; },
+        [](std::size_t d){ return 4.0 * 8 * d; });
+
+    EVB_TWO_PASS_NS("etl",
         [](std::size_t d){ return std::make_tuple(etl_dvec(d), etl_dvec(d), etl_dvec(d), etl_dvec(d)); },
         [](etl_dvec& r, etl_dvec& a, etl_dvec& b, etl_dvec& c){ r = a + b + c; }
         );
 
-    CPM_TWO_PASS_NS("blaze",
+    EVB_TWO_PASS_NS("blaze",
         [](std::size_t d){ return std::make_tuple(blaze_dvec(d), blaze_dvec(d), blaze_dvec(d), blaze_dvec(d)); },
         [](blaze_dvec& r, blaze_dvec& a, blaze_dvec& b, blaze_dvec& c){ r = a + b + c; }
         );
 
-    CPM_TWO_PASS_NS("eigen",
+    EVB_TWO_PASS_NS("eigen",
         [](std::size_t d){ return std::make_tuple(eigen_dvec(d), eigen_dvec(d), eigen_dvec(d), eigen_dvec(d)); },
         [](eigen_dvec& r, eigen_dvec& a, eigen_dvec& b, eigen_dvec& c){ r = a + b + c; }
         );
 }
 
-CPM_SECTION_P("r = a + b + c + d", VALUES_POLICY(500000, 1000000, 1500000, 2000000, 2500000, 3000000, 3500000, 4000000))
-    CPM_TWO_PASS_NS("etl",
+EVB_SECTION_P("r = a + b + c + d", VALUES_POLICY(500000, 1000000, 1500000, 2000000, 2500000, 3000000, 3500000, 4000000))
+    EVB_COST(double,
+        [](std::size_t d){ return 3.0 * d; },
+        [](std::size_t d){ return 5.0 * 8 * d; });
+
+    EVB_TWO_PASS_NS("etl",
         [](std::size_t d){ return std::make_tuple(etl_dvec(d), etl_dvec(d), etl_dvec(d), etl_dvec(d), etl_dvec(d)); },
         [](etl_dvec& r, etl_dvec& a, etl_dvec& b, etl_dvec& c, etl_dvec& d){ r = a + b + c + d; }
         );
 
-    CPM_TWO_PASS_NS("blaze",
+    EVB_TWO_PASS_NS("blaze",
         [](std::size_t d){ return std::make_tuple(blaze_dvec(d), blaze_dvec(d), blaze_dvec(d), blaze_dvec(d), blaze_dvec(d)); },
         [](blaze_dvec& r, blaze_dvec& a, blaze_dvec& b, blaze_dvec& c, blaze_dvec& d){ r = a + b + c + d; }
         );
 
-    CPM_TWO_PASS_NS("eigen",
+    EVB_TWO_PASS_NS("eigen",
         [](std::size_t d){ return std::make_tuple(eigen_dvec(d), eigen_dvec(d), eigen_dvec(d), eigen_dvec(d), eigen_dvec(d)); },
         [](eigen_dvec& r, eigen_dvec& a, eigen_dvec& b, eigen_dvec& c, eigen_dvec& d){ r = a + b + c + d; }
         );
 }
 
-CPM_SECTION_P("R = A'", NARY_POLICY(VALUES_POLICY(64, 64, 128, 256, 256, 256, 300, 512, 512, 1024, 2048, 2048), VALUES_POLICY(64, 128, 128, 128, 256, 384, 500, 512, 1024, 1024, 1024, 2048)))
-    CPM_TWO_PASS_NS("etl",
+EVB_SECTION_P("R = A'", NARY_POLICY(VALUES_POLICY(64, 64, 128, 256, 256, 256, 300, 512, 512, 1024, 2048, 2048), VALUES_POLICY(64, 128, 128, 128, 256, 384, 500, 512, 1024, 1024, 1024, 2048)))
+    EVB_COST(double,
+        [](std::size_t, std::size_t){ return 0.0; },
+        [](std::size_t d1, std::size_t d2){ return 2.0 * 8 * d1 * d2; });
+
+    EVB_TWO_PASS_NS("etl-rm",
         [](std::size_t d1, std::size_t d2){ return std::make_tuple(etl_dmat(d1,d2), etl_dmat(d2,d1)); },
         [](etl_dmat& R, etl_dmat& A){ R = etl::transpose(A); }
         );
 
-    CPM_TWO_PASS_NS("blaze",
-        [](std::size_t d1, std::size_t d2){ return std::make_tuple(blaze_dmat(d1,d2), blaze_dmat(d1,d2)); },
+    EVB_TWO_PASS_NS("etl-cm",
+        [](std::size_t d1, std::size_t d2){ return std::make_tuple(etl_dmat_cm(d1,d2), etl_dmat_cm(d2,d1)); },
+        [](etl_dmat_cm& R, etl_dmat_cm& A){ R = etl::transpose(A); }
+        );
+
+    EVB_TWO_PASS_NS("blaze-rm",
+        [](std::size_t d1, std::size_t d2){ return std::make_tuple(blaze_dmat(d1,d2), blaze_dmat(d2,d1)); },
         [](blaze_dmat& R, blaze_dmat& A){ R = trans(A); }
         );
 
-    CPM_TWO_PASS_NS("eigen",
-        [](std::size_t d1, std::size_t d2){ return std::make_tuple(eigen_dmat(d1,d2), eigen_dmat(d1,d2)); },
+    EVB_TWO_PASS_NS("blaze-cm",
+        [](std::size_t d1, std::size_t d2){ return std::make_tuple(blaze_dmat_cm(d1,d2), blaze_dmat_cm(d2,d1)); },
+        [](blaze_dmat_cm& R, blaze_dmat_cm& A){ R = trans(A); }
+        );
+
+    // R and A have the same layout in memory, the transposition is only a copy
+    EVB_TWO_PASS_NS("blaze-cm=rm'",
+        [](std::size_t d1, std::size_t d2){ return std::make_tuple(blaze_dmat_cm(d1,d2), blaze_dmat(d2,d1)); },
+        [](blaze_dmat_cm& R, blaze_dmat& A){ R = trans(A); }
+        );
+
+    EVB_TWO_PASS_NS("eigen-rm",
+        [](std::size_t d1, std::size_t d2){ return std::make_tuple(eigen_dmat_rm(d1,d2), eigen_dmat_rm(d2,d1)); },
+        [](eigen_dmat_rm& R, eigen_dmat_rm& A){ R = A.transpose(); }
+        );
+
+    EVB_TWO_PASS_NS("eigen-cm",
+        [](std::size_t d1, std::size_t d2){ return std::make_tuple(eigen_dmat(d1,d2), eigen_dmat(d2,d1)); },
         [](eigen_dmat& R, eigen_dmat& A){ R = A.transpose(); }
         );
+
+    EVB_TWO_PASS_NS("eigen-cm=rm'",
+        [](std::size_t d1, std::size_t d2){ return std::make_tuple(eigen_dmat(d1,d2), eigen_dmat_rm(d2,d1)); },
+        [](eigen_dmat& R, eigen_dmat_rm& A){ R = A.transpose(); }
+        );
 }
 
-CPM_SECTION_P("R = R'", NARY_POLICY(VALUES_POLICY(64, 64, 128, 256, 256, 256, 300, 512, 512, 1024, 2048, 2048), VALUES_POLICY(64, 128, 128, 128, 256, 384, 500, 512, 1024, 1024, 1024, 2048)))
-    CPM_TWO_PASS_NS("etl",
+EVB_SECTION_P("R = R'", NARY_POLICY(VALUES_POLICY(64, 64, 128, 256, 256, 256, 300, 512, 512, 1024, 2048, 2048), VALUES_POLICY(64, 128, 128, 128, 256, 384, 500, 512, 1024, 1024, 1024, 2048)))
+    EVB_COST(double,
+        [](std::size_t, std::size_t){ return 0.0; },
+        [](std::size_t d1, std::size_t d2){ return 2.0 * 8 * d1 * d2; });
+
+    EVB_TWO_PASS_NS("etl-rm",
         [](std::size_t d1, std::size_t d2){ return std::make_tuple(etl_dmat(d1,d2)); },
         [](etl_dmat& R){ R.transpose_inplace(); }
         );
 
-    CPM_TWO_PASS_NS("blaze",
+    EVB_TWO_PASS_NS("etl-cm",
+        [](std::size_t d1, std::size_t d2){ return std::make_tuple(etl_dmat_cm(d1,d2)); },
+        [](etl_dmat_cm& R){ R.transpose_inplace(); }
+        );
+
+    EVB_TWO_PASS_NS("blaze-rm",
         [](std::size_t d1, std::size_t d2){ return std::make_tuple(blaze_dmat(d1,d2)); },
         [](blaze_dmat& R){ R.transpose(); }
         );
 
-    CPM_TWO_PASS_NS("eigen",
+    EVB_TWO_PASS_NS("blaze-cm",
+        [](std::size_t d1, std::size_t d2){ return std::make_tuple(blaze_dmat_cm(d1,d2)); },
+        [](blaze_dmat_cm& R){ R.transpose(); }
+        );
+
+    EVB_TWO_PASS_NS("eigen-rm",
+        [](std::size_t d1, std::size_t d2){ return std::make_tuple(eigen_dmat_rm(d1,d2)); },
+        [](eigen_dmat_rm& R){ R.transposeInPlace(); }
+        );
+
+    EVB_TWO_PASS_NS("eigen-cm",
         [](std::size_t d1, std::size_t d2){ return std::make_tuple(eigen_dmat(d1,d2)); },
         [](eigen_dmat& R){ R.transposeInPlace(); }
         );
 }
 
-CPM_SECTION_P("r = a * B", NARY_POLICY(VALUES_POLICY(16, 32, 64, 128, 256, 512, 1024, 2048), VALUES_POLICY(16, 32, 64, 128, 256, 512, 1024, 2048)))
-    CPM_TWO_PASS_NS("etl",
+// The cost of a conversion between storage orders, compared to a copy in the
+// same storage order ("-copy")
+
+EVB_SECTION_P("R = A (row-major to column-major)", NARY_POLICY(VALUES_POLICY(64, 64, 128, 256, 256, 256, 300, 512, 512, 1024, 2048, 2048), VALUES_POLICY(64, 128, 128, 128, 256, 384, 500, 512, 1024, 1024, 1024, 2048)))
+    EVB_COST(double,
+        [](std::size_t, std::size_t){ return 0.0; },
+        [](std::size_t d1, std::size_t d2){ return 2.0 * 8 * d1 * d2; });
+
+    EVB_PASSES("-copy", [](std::size_t d1, std::size_t d2){ return 8.0 * d1 * d2; });
+
+    EVB_TWO_PASS_NS("etl",
+        [](std::size_t d1, std::size_t d2){ return std::make_tuple(etl_dmat_cm(d1,d2), etl_dmat(d1,d2)); },
+        [](etl_dmat_cm& R, etl_dmat& A){ R = A; }
+        );
+
+    EVB_TWO_PASS_NS("etl-copy",
+        [](std::size_t d1, std::size_t d2){ return std::make_tuple(etl_dmat(d1,d2), etl_dmat(d1,d2)); },
+        [](etl_dmat& R, etl_dmat& A){ R = A; }
+        );
+
+    EVB_TWO_PASS_NS("blaze",
+        [](std::size_t d1, std::size_t d2){ return std::make_tuple(blaze_dmat_cm(d1,d2), blaze_dmat(d1,d2)); },
+        [](blaze_dmat_cm& R, blaze_dmat& A){ R = A; }
+        );
+
+    EVB_TWO_PASS_NS("blaze-copy",
+        [](std::size_t d1, std::size_t d2){ return std::make_tuple(blaze_dmat(d1,d2), blaze_dmat(d1,d2)); },
+        [](blaze_dmat& R, blaze_dmat& A){ R = A; }
+        );
+
+    EVB_TWO_PASS_NS("eigen",
+        [](std::size_t d1, std::size_t d2){ return std::make_tuple(eigen_dmat(d1,d2), eigen_dmat_rm(d1,d2)); },
+        [](eigen_dmat& R, eigen_dmat_rm& A){ R = A; }
+        );
+
+    EVB_TWO_PASS_NS("eigen-copy",
+        [](std::size_t d1, std::size_t d2){ return std::make_tuple(eigen_dmat_rm(d1,d2), eigen_dmat_rm(d1,d2)); },
+        [](eigen_dmat_rm& R, eigen_dmat_rm& A){ R = A; }
+        );
+}
+
+EVB_SECTION_P("R = A (column-major to row-major)", NARY_POLICY(VALUES_POLICY(64, 64, 128, 256, 256, 256, 300, 512, 512, 1024, 2048, 2048), VALUES_POLICY(64, 128, 128, 128, 256, 384, 500, 512, 1024, 1024, 1024, 2048)))
+    EVB_COST(double,
+        [](std::size_t, std::size_t){ return 0.0; },
+        [](std::size_t d1, std::size_t d2){ return 2.0 * 8 * d1 * d2; });
+
+    EVB_PASSES("-copy", [](std::size_t d1, std::size_t d2){ return 8.0 * d1 * d2; });
+
+    EVB_TWO_PASS_NS("etl",
+        [](std::size_t d1, std::size_t d2){ return std::make_tuple(etl_dmat(d1,d2), etl_dmat_cm(d1,d2)); },
+        [](etl_dmat& R, etl_dmat_cm& A){ R = A; }
+        );
+
+    EVB_TWO_PASS_NS("etl-copy",
+        [](std::size_t d1, std::size_t d2){ return std::make_tuple(etl_dmat_cm(d1,d2), etl_dmat_cm(d1,d2)); },
+        [](etl_dmat_cm& R, etl_dmat_cm& A){ R = A; }
+        );
+
+    EVB_TWO_PASS_NS("blaze",
+        [](std::size_t d1, std::size_t d2){ return std::make_tuple(blaze_dmat(d1,d2), blaze_dmat_cm(d1,d2)); },
+        [](blaze_dmat& R, blaze_dmat_cm& A){ R = A; }
+        );
+
+    EVB_TWO_PASS_NS("blaze-copy",
+        [](std::size_t d1, std::size_t d2){ return std::make_tuple(blaze_dmat_cm(d1,d2), blaze_dmat_cm(d1,d2)); },
+        [](blaze_dmat_cm& R, blaze_dmat_cm& A){ R = A; }
+        );
+
+    EVB_TWO_PASS_NS("eigen",
+        [](std::size_t d1, std::size_t d2){ return std::make_tuple(eigen_dmat_rm(d1,d2), eigen_dmat(d1,d2)); },
+        [](eigen_dmat_rm& R, eigen_dmat& A){ R = A; }
+        );
+
+    EVB_TWO_PASS_NS("eigen-copy",
+        [](std::size_t d1, std::size_t d2){ return std::make_tuple(eigen_dmat(d1,d2), eigen_dmat(d1,d2)); },
+        [](eigen_dmat& R, eigen_dmat& A){ R = A; }
+        );
+}
+
+EVB_SECTION_P("r = a * B", NARY_POLICY(VALUES_POLICY(16, 32, 64, 128, 256, 512, 1024, 2048), VALUES_POLICY(16, 32, 64, 128, 256, 512, 1024, 2048)))
+    EVB_COST(double,
+        [](std::size_t d1, std::size_t d2){ return 2.0 * d1 * d2; },
+        [](std::size_t d1, std::size_t d2){ return 8.0 * (d1 * d2 + d1 + d2); });
+
+    EVB_TWO_PASS_NS("etl-rm",
         [](std::size_t d1, std::size_t d2){ return std::make_tuple(etl_dvec(d1), etl_dmat(d1, d2), etl_dvec(d2)); },
         [](etl_dvec& a, etl_dmat& B, etl_dvec& r){ r = a * B; }
         );
 
-    CPM_TWO_PASS_NS("blaze",
+    EVB_TWO_PASS_NS("etl-cm",
+        [](std::size_t d1, std::size_t d2){ return std::make_tuple(etl_dvec(d1), etl_dmat_cm(d1, d2), etl_dvec(d2)); },
+        [](etl_dvec& a, etl_dmat_cm& B, etl_dvec& r){ r = a * B; }
+        );
+
+    EVB_TWO_PASS_NS("blaze-rm",
         [](std::size_t d1, std::size_t d2){ return std::make_tuple(blaze_dvec_row(d1), blaze_dmat(d1, d2), blaze_dvec_row(d2)); },
         [](blaze_dvec_row& a, blaze_dmat& B, blaze_dvec_row& r){ r = a * B; }
         );
 
-    CPM_TWO_PASS_NS("eigen",
+    EVB_TWO_PASS_NS("blaze-cm",
+        [](std::size_t d1, std::size_t d2){ return std::make_tuple(blaze_dvec_row(d1), blaze_dmat_cm(d1, d2), blaze_dvec_row(d2)); },
+        [](blaze_dvec_row& a, blaze_dmat_cm& B, blaze_dvec_row& r){ r = a * B; }
+        );
+
+    EVB_TWO_PASS_NS("eigen-rm",
+        [](std::size_t d1, std::size_t d2){ return std::make_tuple(eigen_dvec(d1), eigen_dmat_rm(d1, d2), eigen_dvec(d2)); },
+        [](eigen_dvec& a, eigen_dmat_rm& B, eigen_dvec& r){ r.transpose() = a.transpose() * B; }
+        );
+
+    EVB_TWO_PASS_NS("eigen-cm",
         [](std::size_t d1, std::size_t d2){ return std::make_tuple(eigen_dvec(d1), eigen_dmat(d1, d2), eigen_dvec(d2)); },
-        [](eigen_dvec& a, eigen_dmat& B, eigen_dvec& r){ r = a * B; }
+        [](eigen_dvec& a, eigen_dmat& B, eigen_dvec& r){ r.transpose() = a.transpose() * B; }
         );
 }
 
@@ -292,148 +446,331 @@ using gemv_policy = NARY_POLICY(
     VALUES_POLICY(16, 32, 64, 128, 256, 512, 1000, 2000, 3000, 4000, 5000, 6000),
     VALUES_POLICY(16, 32, 64, 128, 256, 512, 1000, 2000, 3000, 4000, 5000, 6000));
 
-CPM_SECTION_P("r = A * b (s)", gemv_policy)
-    CPM_TWO_PASS_NS("etl-vec",
+EVB_SECTION_P("r = A * b (s)", gemv_policy)
+    EVB_COST(float,
+        [](std::size_t d1, std::size_t d2){ return 2.0 * d1 * d2; },
+        [](std::size_t d1, std::size_t d2){ return 4.0 * (d1 * d2 + d1 + d2); });
+
+    EVB_TWO_PASS_NS("etl-vec-rm",
         [](std::size_t d1, std::size_t d2){ return std::make_tuple(etl_smat(d1, d2), etl_svec(d2), etl_svec(d1)); },
         [](etl_smat& A, etl_svec& b, etl_svec& r){ r = selected_helper(etl::gemm_impl::VEC, A * b); }
         );
 
-    CPM_TWO_PASS_NS("etl-blas",
+#ifdef EVB_BLAS
+    EVB_TWO_PASS_NS("etl-blas-rm",
         [](std::size_t d1, std::size_t d2){ return std::make_tuple(etl_smat(d1, d2), etl_svec(d2), etl_svec(d1)); },
         [](etl_smat& A, etl_svec& b, etl_svec& r){ r = selected_helper(etl::gemm_impl::BLAS, A * b); }
         );
+#endif
 
-    CPM_TWO_PASS_NS("blaze",
+    EVB_TWO_PASS_NS("etl-cm",
+        [](std::size_t d1, std::size_t d2){ return std::make_tuple(etl_smat_cm(d1, d2), etl_svec(d2), etl_svec(d1)); },
+        [](etl_smat_cm& A, etl_svec& b, etl_svec& r){ r = A * b; }
+        );
+
+    EVB_TWO_PASS_NS("blaze-rm",
         [](std::size_t d1, std::size_t d2){ return std::make_tuple(blaze_smat(d1, d2), blaze_svec(d2), blaze_svec(d1)); },
         [](blaze_smat& A, blaze_svec& b, blaze_svec& r){ r = A * b; }
         );
 
-    CPM_TWO_PASS_NS("eigen",
+    EVB_TWO_PASS_NS("blaze-cm",
+        [](std::size_t d1, std::size_t d2){ return std::make_tuple(blaze_smat_cm(d1, d2), blaze_svec(d2), blaze_svec(d1)); },
+        [](blaze_smat_cm& A, blaze_svec& b, blaze_svec& r){ r = A * b; }
+        );
+
+    EVB_TWO_PASS_NS("eigen-rm",
+        [](std::size_t d1, std::size_t d2){ return std::make_tuple(eigen_smat_rm(d1, d2), eigen_svec(d2), eigen_svec(d1)); },
+        [](eigen_smat_rm& A, eigen_svec& b, eigen_svec& r){ r = A * b; }
+        );
+
+    EVB_TWO_PASS_NS("eigen-cm",
         [](std::size_t d1, std::size_t d2){ return std::make_tuple(eigen_smat(d1, d2), eigen_svec(d2), eigen_svec(d1)); },
         [](eigen_smat& A, eigen_svec& b, eigen_svec& r){ r = A * b; }
         );
 }
 
-CPM_SECTION_P("r = A * b (d)", gemv_policy)
-    CPM_TWO_PASS_NS("etl-vec",
+EVB_SECTION_P("r = A * b (d)", gemv_policy)
+    EVB_COST(double,
+        [](std::size_t d1, std::size_t d2){ return 2.0 * d1 * d2; },
+        [](std::size_t d1, std::size_t d2){ return 8.0 * (d1 * d2 + d1 + d2); });
+
+    EVB_TWO_PASS_NS("etl-vec-rm",
         [](std::size_t d1, std::size_t d2){ return std::make_tuple(etl_dmat(d1, d2), etl_dvec(d2), etl_dvec(d1)); },
         [](etl_dmat& A, etl_dvec& b, etl_dvec& r){ r = selected_helper(etl::gemm_impl::VEC, A * b); }
         );
 
-    CPM_TWO_PASS_NS("etl-blas",
+#ifdef EVB_BLAS
+    EVB_TWO_PASS_NS("etl-blas-rm",
         [](std::size_t d1, std::size_t d2){ return std::make_tuple(etl_dmat(d1, d2), etl_dvec(d2), etl_dvec(d1)); },
         [](etl_dmat& A, etl_dvec& b, etl_dvec& r){ r = selected_helper(etl::gemm_impl::BLAS, A * b); }
         );
+#endif
 
-    CPM_TWO_PASS_NS("blaze",
+    EVB_TWO_PASS_NS("etl-cm",
+        [](std::size_t d1, std::size_t d2){ return std::make_tuple(etl_dmat_cm(d1, d2), etl_dvec(d2), etl_dvec(d1)); },
+        [](etl_dmat_cm& A, etl_dvec& b, etl_dvec& r){ r = A * b; }
+        );
+
+    EVB_TWO_PASS_NS("blaze-rm",
         [](std::size_t d1, std::size_t d2){ return std::make_tuple(blaze_dmat(d1, d2), blaze_dvec(d2), blaze_dvec(d1)); },
         [](blaze_dmat& A, blaze_dvec& b, blaze_dvec& r){ r = A * b; }
         );
 
-    CPM_TWO_PASS_NS("eigen",
+    EVB_TWO_PASS_NS("blaze-cm",
+        [](std::size_t d1, std::size_t d2){ return std::make_tuple(blaze_dmat_cm(d1, d2), blaze_dvec(d2), blaze_dvec(d1)); },
+        [](blaze_dmat_cm& A, blaze_dvec& b, blaze_dvec& r){ r = A * b; }
+        );
+
+    EVB_TWO_PASS_NS("eigen-rm",
+        [](std::size_t d1, std::size_t d2){ return std::make_tuple(eigen_dmat_rm(d1, d2), eigen_dvec(d2), eigen_dvec(d1)); },
+        [](eigen_dmat_rm& A, eigen_dvec& b, eigen_dvec& r){ r = A * b; }
+        );
+
+    EVB_TWO_PASS_NS("eigen-cm",
         [](std::size_t d1, std::size_t d2){ return std::make_tuple(eigen_dmat(d1, d2), eigen_dvec(d2), eigen_dvec(d1)); },
         [](eigen_dmat& A, eigen_dvec& b, eigen_dvec& r){ r = A * b; }
         );
 }
 
-CPM_SECTION_P("R = A * B", NARY_POLICY(VALUES_POLICY(128, 128, 256, 256, 300, 512, 768), VALUES_POLICY(32, 128, 128, 256, 200, 512, 768), VALUES_POLICY(64, 128, 256, 256, 400, 512, 768)))
-    CPM_TWO_PASS_NS("etl",
+EVB_SECTION_P("R = A * B", NARY_POLICY(VALUES_POLICY(128, 128, 256, 256, 300, 512, 768), VALUES_POLICY(32, 128, 128, 256, 200, 512, 768), VALUES_POLICY(64, 128, 256, 256, 400, 512, 768)))
+    EVB_COST(double,
+        [](std::size_t d1, std::size_t d2, std::size_t d3){ return 2.0 * d1 * d2 * d3; },
+        [](std::size_t d1, std::size_t d2, std::size_t d3){ return 8.0 * (d1 * d2 + d2 * d3 + d1 * d3); });
+
+    EVB_TWO_PASS_NS("etl-rm",
         [](std::size_t d1, std::size_t d2, std::size_t d3){ return std::make_tuple(etl_dmat(d1,d2), etl_dmat(d2, d3), etl_dmat(d1,d3)); },
         [](etl_dmat& A, etl_dmat& B, etl_dmat& R){ R = A * B; }
         );
 
-    CPM_TWO_PASS_NS("blaze",
+    EVB_TWO_PASS_NS("etl-cm",
+        [](std::size_t d1, std::size_t d2, std::size_t d3){ return std::make_tuple(etl_dmat_cm(d1,d2), etl_dmat_cm(d2, d3), etl_dmat_cm(d1,d3)); },
+        [](etl_dmat_cm& A, etl_dmat_cm& B, etl_dmat_cm& R){ R = A * B; }
+        );
+
+    EVB_TWO_PASS_NS("blaze-rm",
         [](std::size_t d1, std::size_t d2, std::size_t d3){ return std::make_tuple(blaze_dmat(d1,d2), blaze_dmat(d2,d3), blaze_dmat(d1,d3)); },
         [](blaze_dmat& A, blaze_dmat& B, blaze_dmat& R){ R = A * B; }
         );
 
-    CPM_TWO_PASS_NS("eigen",
+    EVB_TWO_PASS_NS("blaze-cm",
+        [](std::size_t d1, std::size_t d2, std::size_t d3){ return std::make_tuple(blaze_dmat_cm(d1,d2), blaze_dmat_cm(d2,d3), blaze_dmat_cm(d1,d3)); },
+        [](blaze_dmat_cm& A, blaze_dmat_cm& B, blaze_dmat_cm& R){ R = A * B; }
+        );
+
+    EVB_TWO_PASS_NS("eigen-rm",
+        [](std::size_t d1, std::size_t d2, std::size_t d3){ return std::make_tuple(eigen_dmat_rm(d1,d2), eigen_dmat_rm(d2,d3), eigen_dmat_rm(d1,d3)); },
+        [](eigen_dmat_rm& A, eigen_dmat_rm& B, eigen_dmat_rm& R){ R = A * B; }
+        );
+
+    EVB_TWO_PASS_NS("eigen-cm",
         [](std::size_t d1, std::size_t d2, std::size_t d3){ return std::make_tuple(eigen_dmat(d1,d2), eigen_dmat(d2,d3), eigen_dmat(d1,d3)); },
         [](eigen_dmat& A, eigen_dmat& B, eigen_dmat& R){ R = A * B; }
         );
+
+    EVB_TWO_PASS_NS("blaze-rm*cm",
+        [](std::size_t d1, std::size_t d2, std::size_t d3){ return std::make_tuple(blaze_dmat(d1,d2), blaze_dmat_cm(d2, d3), blaze_dmat(d1,d3)); },
+        [](blaze_dmat& A, blaze_dmat_cm& B, blaze_dmat& R){ R = A * B; }
+        );
+
+    EVB_TWO_PASS_NS("blaze-cm*rm",
+        [](std::size_t d1, std::size_t d2, std::size_t d3){ return std::make_tuple(blaze_dmat_cm(d1,d2), blaze_dmat(d2, d3), blaze_dmat_cm(d1,d3)); },
+        [](blaze_dmat_cm& A, blaze_dmat& B, blaze_dmat_cm& R){ R = A * B; }
+        );
+
+    EVB_TWO_PASS_NS("eigen-rm*cm",
+        [](std::size_t d1, std::size_t d2, std::size_t d3){ return std::make_tuple(eigen_dmat_rm(d1,d2), eigen_dmat(d2, d3), eigen_dmat_rm(d1,d3)); },
+        [](eigen_dmat_rm& A, eigen_dmat& B, eigen_dmat_rm& R){ R = A * B; }
+        );
+
+    EVB_TWO_PASS_NS("eigen-cm*rm",
+        [](std::size_t d1, std::size_t d2, std::size_t d3){ return std::make_tuple(eigen_dmat(d1,d2), eigen_dmat_rm(d2, d3), eigen_dmat(d1,d3)); },
+        [](eigen_dmat& A, eigen_dmat_rm& B, eigen_dmat& R){ R = A * B; }
+        );
 }
 
-CPM_SECTION_P("R = A * B'", NARY_POLICY(VALUES_POLICY(128, 128, 256, 256, 300, 512, 768), VALUES_POLICY(32, 128, 128, 256, 200, 512, 768), VALUES_POLICY(64, 128, 256, 256, 400, 512, 768)))
-    CPM_TWO_PASS_NS("etl",
+EVB_SECTION_P("R = A * B'", NARY_POLICY(VALUES_POLICY(128, 128, 256, 256, 300, 512, 768), VALUES_POLICY(32, 128, 128, 256, 200, 512, 768), VALUES_POLICY(64, 128, 256, 256, 400, 512, 768)))
+    EVB_COST(double,
+        [](std::size_t d1, std::size_t d2, std::size_t d3){ return 2.0 * d1 * d2 * d3; },
+        [](std::size_t d1, std::size_t d2, std::size_t d3){ return 8.0 * (d1 * d2 + d2 * d3 + d1 * d3); });
+
+    EVB_TWO_PASS_NS("etl-rm",
         [](std::size_t d1, std::size_t d2, std::size_t d3){ return std::make_tuple(etl_dmat(d1,d2), etl_dmat(d3, d2), etl_dmat(d1,d3)); },
         [](etl_dmat& A, etl_dmat& B, etl_dmat& R){ R = A * etl::transpose(B); }
         );
 
-    CPM_TWO_PASS_NS("blaze",
+    EVB_TWO_PASS_NS("etl-cm",
+        [](std::size_t d1, std::size_t d2, std::size_t d3){ return std::make_tuple(etl_dmat_cm(d1,d2), etl_dmat_cm(d3, d2), etl_dmat_cm(d1,d3)); },
+        [](etl_dmat_cm& A, etl_dmat_cm& B, etl_dmat_cm& R){ R = A * etl::transpose(B); }
+        );
+
+    EVB_TWO_PASS_NS("blaze-rm",
         [](std::size_t d1, std::size_t d2, std::size_t d3){ return std::make_tuple(blaze_dmat(d1,d2), blaze_dmat(d3, d2), blaze_dmat(d1,d3)); },
         [](blaze_dmat& A, blaze_dmat& B, blaze_dmat& R){ R = A * blaze::trans(B); }
         );
 
-    CPM_TWO_PASS_NS("eigen",
+    EVB_TWO_PASS_NS("blaze-cm",
+        [](std::size_t d1, std::size_t d2, std::size_t d3){ return std::make_tuple(blaze_dmat_cm(d1,d2), blaze_dmat_cm(d3, d2), blaze_dmat_cm(d1,d3)); },
+        [](blaze_dmat_cm& A, blaze_dmat_cm& B, blaze_dmat_cm& R){ R = A * blaze::trans(B); }
+        );
+
+    EVB_TWO_PASS_NS("eigen-rm",
+        [](std::size_t d1, std::size_t d2, std::size_t d3){ return std::make_tuple(eigen_dmat_rm(d1,d2), eigen_dmat_rm(d3, d2), eigen_dmat_rm(d1,d3)); },
+        [](eigen_dmat_rm& A, eigen_dmat_rm& B, eigen_dmat_rm& R){ R = A * B.transpose(); }
+        );
+
+    EVB_TWO_PASS_NS("eigen-cm",
         [](std::size_t d1, std::size_t d2, std::size_t d3){ return std::make_tuple(eigen_dmat(d1,d2), eigen_dmat(d3, d2), eigen_dmat(d1,d3)); },
         [](eigen_dmat& A, eigen_dmat& B, eigen_dmat& R){ R = A * B.transpose(); }
         );
+
+    EVB_TWO_PASS_NS("blaze-rm*cm",
+        [](std::size_t d1, std::size_t d2, std::size_t d3){ return std::make_tuple(blaze_dmat(d1,d2), blaze_dmat_cm(d3, d2), blaze_dmat(d1,d3)); },
+        [](blaze_dmat& A, blaze_dmat_cm& B, blaze_dmat& R){ R = A * blaze::trans(B); }
+        );
+
+    EVB_TWO_PASS_NS("blaze-cm*rm",
+        [](std::size_t d1, std::size_t d2, std::size_t d3){ return std::make_tuple(blaze_dmat_cm(d1,d2), blaze_dmat(d3, d2), blaze_dmat_cm(d1,d3)); },
+        [](blaze_dmat_cm& A, blaze_dmat& B, blaze_dmat_cm& R){ R = A * blaze::trans(B); }
+        );
+
+    EVB_TWO_PASS_NS("eigen-rm*cm",
+        [](std::size_t d1, std::size_t d2, std::size_t d3){ return std::make_tuple(eigen_dmat_rm(d1,d2), eigen_dmat(d3, d2), eigen_dmat_rm(d1,d3)); },
+        [](eigen_dmat_rm& A, eigen_dmat& B, eigen_dmat_rm& R){ R = A * B.transpose(); }
+        );
+
+    EVB_TWO_PASS_NS("eigen-cm*rm",
+        [](std::size_t d1, std::size_t d2, std::size_t d3){ return std::make_tuple(eigen_dmat(d1,d2), eigen_dmat_rm(d3, d2), eigen_dmat(d1,d3)); },
+        [](eigen_dmat& A, eigen_dmat_rm& B, eigen_dmat& R){ R = A * B.transpose(); }
+        );
 }
 
-CPM_SECTION_P("R = A * (B + C)", NARY_POLICY(VALUES_POLICY(100, 200, 300, 400, 500, 600, 700, 800, 900, 1000), VALUES_POLICY(100, 200, 300, 400, 500, 600, 700, 800, 900, 1000)))
-    CPM_TWO_PASS_NS("etl",
+EVB_SECTION_P("R = A * (B + C)", NARY_POLICY(VALUES_POLICY(100, 200, 300, 400, 500, 600, 700, 800, 900, 1000), VALUES_POLICY(100, 200, 300, 400, 500, 600, 700, 800, 900, 1000)))
+    EVB_COST(double,
+        [](std::size_t d1, std::size_t d2){ return 1.0 * d1 * d2 + 2.0 * d1 * d2 * d2; },
+        [](std::size_t d1, std::size_t d2){ return 4.0 * 8 * d1 * d2; });
+
+    EVB_TWO_PASS_NS("etl-rm",
         [](std::size_t d1, std::size_t d2){ return std::make_tuple(etl_dmat(d1,d2), etl_dmat(d1,d2), etl_dmat(d1,d2), etl_dmat(d1,d2)); },
         [](etl_dmat& R, etl_dmat& A, etl_dmat& B, etl_dmat& C){ R = A * (B + C); }
         );
 
-    CPM_TWO_PASS_NS("blaze",
+    EVB_TWO_PASS_NS("etl-cm",
+        [](std::size_t d1, std::size_t d2){ return std::make_tuple(etl_dmat_cm(d1,d2), etl_dmat_cm(d1,d2), etl_dmat_cm(d1,d2), etl_dmat_cm(d1,d2)); },
+        [](etl_dmat_cm& R, etl_dmat_cm& A, etl_dmat_cm& B, etl_dmat_cm& C){ R = A * (B + C); }
+        );
+
+    EVB_TWO_PASS_NS("blaze-rm",
         [](std::size_t d1, std::size_t d2){ return std::make_tuple(blaze_dmat(d1,d2), blaze_dmat(d1,d2), blaze_dmat(d1,d2), blaze_dmat(d1,d2)); },
         [](blaze_dmat& R, blaze_dmat& A, blaze_dmat& B, blaze_dmat& C){ R = A * (B + C); }
         );
 
-    CPM_TWO_PASS_NS("eigen",
+    EVB_TWO_PASS_NS("blaze-cm",
+        [](std::size_t d1, std::size_t d2){ return std::make_tuple(blaze_dmat_cm(d1,d2), blaze_dmat_cm(d1,d2), blaze_dmat_cm(d1,d2), blaze_dmat_cm(d1,d2)); },
+        [](blaze_dmat_cm& R, blaze_dmat_cm& A, blaze_dmat_cm& B, blaze_dmat_cm& C){ R = A * (B + C); }
+        );
+
+    EVB_TWO_PASS_NS("eigen-rm",
+        [](std::size_t d1, std::size_t d2){ return std::make_tuple(eigen_dmat_rm(d1,d2), eigen_dmat_rm(d1,d2), eigen_dmat_rm(d1,d2), eigen_dmat_rm(d1,d2)); },
+        [](eigen_dmat_rm& R, eigen_dmat_rm& A, eigen_dmat_rm& B, eigen_dmat_rm& C){ R = A * (B + C); }
+        );
+
+    EVB_TWO_PASS_NS("eigen-cm",
         [](std::size_t d1, std::size_t d2){ return std::make_tuple(eigen_dmat(d1,d2), eigen_dmat(d1,d2), eigen_dmat(d1,d2), eigen_dmat(d1,d2)); },
         [](eigen_dmat& R, eigen_dmat& A, eigen_dmat& B, eigen_dmat& C){ R = A * (B + C); }
         );
 }
 
-CPM_SECTION_P("R = A * (B * C)", NARY_POLICY(VALUES_POLICY(100, 200, 300, 400, 500, 600, 700, 800, 900, 1000), VALUES_POLICY(100, 200, 300, 400, 500, 600, 700, 800, 900, 1000)))
-    CPM_TWO_PASS_NS("etl",
+EVB_SECTION_P("R = A * (B * C)", NARY_POLICY(VALUES_POLICY(100, 200, 300, 400, 500, 600, 700, 800, 900, 1000), VALUES_POLICY(100, 200, 300, 400, 500, 600, 700, 800, 900, 1000)))
+    EVB_COST(double,
+        [](std::size_t d1, std::size_t d2){ return 4.0 * d1 * d2 * d2; },
+        [](std::size_t d1, std::size_t d2){ return 4.0 * 8 * d1 * d2; });
+
+    EVB_TWO_PASS_NS("etl-rm",
         [](std::size_t d1, std::size_t d2){ return std::make_tuple(etl_dmat(d1,d2), etl_dmat(d1,d2), etl_dmat(d1,d2), etl_dmat(d1,d2)); },
         [](etl_dmat& R, etl_dmat& A, etl_dmat& B, etl_dmat& C){ R = A * (B * C); }
         );
 
-    CPM_TWO_PASS_NS("blaze",
+    EVB_TWO_PASS_NS("etl-cm",
+        [](std::size_t d1, std::size_t d2){ return std::make_tuple(etl_dmat_cm(d1,d2), etl_dmat_cm(d1,d2), etl_dmat_cm(d1,d2), etl_dmat_cm(d1,d2)); },
+        [](etl_dmat_cm& R, etl_dmat_cm& A, etl_dmat_cm& B, etl_dmat_cm& C){ R = A * (B * C); }
+        );
+
+    EVB_TWO_PASS_NS("blaze-rm",
         [](std::size_t d1, std::size_t d2){ return std::make_tuple(blaze_dmat(d1,d2), blaze_dmat(d1,d2), blaze_dmat(d1,d2), blaze_dmat(d1,d2)); },
         [](blaze_dmat& R, blaze_dmat& A, blaze_dmat& B, blaze_dmat& C){ R = A * (B * C); }
         );
 
-    CPM_TWO_PASS_NS("eigen",
+    EVB_TWO_PASS_NS("blaze-cm",
+        [](std::size_t d1, std::size_t d2){ return std::make_tuple(blaze_dmat_cm(d1,d2), blaze_dmat_cm(d1,d2), blaze_dmat_cm(d1,d2), blaze_dmat_cm(d1,d2)); },
+        [](blaze_dmat_cm& R, blaze_dmat_cm& A, blaze_dmat_cm& B, blaze_dmat_cm& C){ R = A * (B * C); }
+        );
+
+    EVB_TWO_PASS_NS("eigen-rm",
+        [](std::size_t d1, std::size_t d2){ return std::make_tuple(eigen_dmat_rm(d1,d2), eigen_dmat_rm(d1,d2), eigen_dmat_rm(d1,d2), eigen_dmat_rm(d1,d2)); },
+        [](eigen_dmat_rm& R, eigen_dmat_rm& A, eigen_dmat_rm& B, eigen_dmat_rm& C){ R = A * (B * C); }
+        );
+
+    EVB_TWO_PASS_NS("eigen-cm",
         [](std::size_t d1, std::size_t d2){ return std::make_tuple(eigen_dmat(d1,d2), eigen_dmat(d1,d2), eigen_dmat(d1,d2), eigen_dmat(d1,d2)); },
         [](eigen_dmat& R, eigen_dmat& A, eigen_dmat& B, eigen_dmat& C){ R = A * (B * C); }
         );
 }
 
-CPM_SECTION_P("R = (A + B) * (C - D)", NARY_POLICY(VALUES_POLICY(100, 200, 300, 400, 500, 600, 700, 800, 900, 1000), VALUES_POLICY(100, 200, 300, 400, 500, 600, 700, 800, 900, 1000)))
-    CPM_TWO_PASS_NS("etl",
+EVB_SECTION_P("R = (A + B) * (C - D)", NARY_POLICY(VALUES_POLICY(100, 200, 300, 400, 500, 600, 700, 800, 900, 1000), VALUES_POLICY(100, 200, 300, 400, 500, 600, 700, 800, 900, 1000)))
+    EVB_COST(double,
+        [](std::size_t d1, std::size_t d2){ return 2.0 * d1 * d2 + 2.0 * d1 * d2 * d2; },
+        [](std::size_t d1, std::size_t d2){ return 5.0 * 8 * d1 * d2; });
+
+    EVB_TWO_PASS_NS("etl-rm",
         [](std::size_t d1, std::size_t d2){ return std::make_tuple(etl_dmat(d1,d2), etl_dmat(d1,d2), etl_dmat(d1,d2), etl_dmat(d1,d2), etl_dmat(d1,d2)); },
         [](etl_dmat& R, etl_dmat& A, etl_dmat& B, etl_dmat& C, etl_dmat& D){ R = (A + B) * (C - D); }
         );
 
-    CPM_TWO_PASS_NS("blaze",
+    EVB_TWO_PASS_NS("etl-cm",
+        [](std::size_t d1, std::size_t d2){ return std::make_tuple(etl_dmat_cm(d1,d2), etl_dmat_cm(d1,d2), etl_dmat_cm(d1,d2), etl_dmat_cm(d1,d2), etl_dmat_cm(d1,d2)); },
+        [](etl_dmat_cm& R, etl_dmat_cm& A, etl_dmat_cm& B, etl_dmat_cm& C, etl_dmat_cm& D){ R = (A + B) * (C - D); }
+        );
+
+    EVB_TWO_PASS_NS("blaze-rm",
         [](std::size_t d1, std::size_t d2){ return std::make_tuple(blaze_dmat(d1,d2), blaze_dmat(d1,d2), blaze_dmat(d1,d2), blaze_dmat(d1,d2), blaze_dmat(d1,d2)); },
         [](blaze_dmat& R, blaze_dmat& A, blaze_dmat& B, blaze_dmat& C, blaze_dmat& D){ R = (A + B) * (C - D); }
         );
 
-    CPM_TWO_PASS_NS("eigen",
+    EVB_TWO_PASS_NS("blaze-cm",
+        [](std::size_t d1, std::size_t d2){ return std::make_tuple(blaze_dmat_cm(d1,d2), blaze_dmat_cm(d1,d2), blaze_dmat_cm(d1,d2), blaze_dmat_cm(d1,d2), blaze_dmat_cm(d1,d2)); },
+        [](blaze_dmat_cm& R, blaze_dmat_cm& A, blaze_dmat_cm& B, blaze_dmat_cm& C, blaze_dmat_cm& D){ R = (A + B) * (C - D); }
+        );
+
+    EVB_TWO_PASS_NS("eigen-rm",
+        [](std::size_t d1, std::size_t d2){ return std::make_tuple(eigen_dmat_rm(d1,d2), eigen_dmat_rm(d1,d2), eigen_dmat_rm(d1,d2), eigen_dmat_rm(d1,d2), eigen_dmat_rm(d1,d2)); },
+        [](eigen_dmat_rm& R, eigen_dmat_rm& A, eigen_dmat_rm& B, eigen_dmat_rm& C, eigen_dmat_rm& D){ R = (A + B) * (C - D); }
+        );
+
+    EVB_TWO_PASS_NS("eigen-cm",
         [](std::size_t d1, std::size_t d2){ return std::make_tuple(eigen_dmat(d1,d2), eigen_dmat(d1,d2), eigen_dmat(d1,d2), eigen_dmat(d1,d2), eigen_dmat(d1,d2)); },
         [](eigen_dmat& R, eigen_dmat& A, eigen_dmat& B, eigen_dmat& C, eigen_dmat& D){ R = (A + B) * (C - D); }
         );
 }
 
-CPM_SECTION_P("dot", VALUES_POLICY(500000, 1000000, 1500000, 2000000, 2500000, 3000000, 3500000, 4000000))
-    CPM_TWO_PASS_NS("etl",
-        [](std::size_t d){ return std::make_tuple(etl_dvec(d), etl_dvec(d), etl_dvec(d)); },
+EVB_SECTION_P("dot", VALUES_POLICY(500000, 1000000, 1500000, 2000000, 2500000, 3000000, 3500000, 4000000))
+    EVB_COST(double,
+        [](std::size_t d){ return 3.0 * d; },
+        [](std::size_t d){ return 4.0 * 8 * d; });
+
+    EVB_OWN_DATA();
+
+    EVB_TWO_PASS_NS("etl",
+        [](std::size_t d){ etl_dvec a(d), b(d), c(d); fill_own_data(a, b, c); normalize_dot(a, b); return std::make_tuple(std::move(a), std::move(b), std::move(c)); },
         [](etl_dvec& a, etl_dvec& b, etl_dvec& c){ c *= etl::dot(a, b); }
         );
 
-    CPM_TWO_PASS_NS("blaze",
-        [](std::size_t d){ return std::make_tuple(blaze_dvec(d), blaze_dvec(d), blaze_dvec(d)); },
+    EVB_TWO_PASS_NS("blaze",
+        [](std::size_t d){ blaze_dvec a(d), b(d), c(d); fill_own_data(a, b, c); normalize_dot(a, b); return std::make_tuple(std::move(a), std::move(b), std::move(c)); },
         [](blaze_dvec& a, blaze_dvec& b, blaze_dvec& c){ c *= (a, b); }
         );
 
-    CPM_TWO_PASS_NS("eigen",
-        [](std::size_t d){ return std::make_tuple(eigen_dvec(d), eigen_dvec(d), eigen_dvec(d)); },
+    EVB_TWO_PASS_NS("eigen",
+        [](std::size_t d){ eigen_dvec a(d), b(d), c(d); fill_own_data(a, b, c); normalize_dot(a, b); return std::make_tuple(std::move(a), std::move(b), std::move(c)); },
         [](eigen_dvec& a, eigen_dvec& b, eigen_dvec& c){ c *= a.dot(b); }
         );
 }
@@ -0,0 +1,329 @@
+#define CPM_LIB
+#include "benchmark.hpp"
+
+#include <eigen3/Eigen/Sparse>
+
+#include "evb/sparse.hpp"
+
+// Sparse kernels on the compressed row-major formats of the libraries. The
+// matrices come from deterministic generators (banded, 2D Poisson stencil,
+// power-law R-MAT graphs) or from Matrix Market files given in EVB_MTX.
+//
+// etl::sparse_matrix is a simple coordinate format with generic kernels, it
+// is only measured on the small sizes.
+
+namespace {
+
+using etl_dsmat   = etl::sparse_matrix<double>;
+using blaze_dsmat = blaze::CompressedMatrix<double>;
+using eigen_dsmat = Eigen::SparseMatrix<double, Eigen::RowMajor>;
+
+etl_dsmat to_etl(const evb::triplets& t){
+    etl_dsmat A(t.rows, t.cols);
+
+    for(std::size_t k = 0; k < t.nnz(); ++k){
+        A.set(t.row[k], t.col[k], t.value[k]);
+    }
+
+    return A;
+}
+
+blaze_dsmat to_blaze(const evb::triplets& t){
+    blaze_dsmat A(t.rows, t.cols);
+    A.reserve(t.nnz());
+
+    std::size_t k = 0;
+
+    for(std::size_t i = 0; i < t.rows; ++i){
+        for(; k < t.nnz() && t.row[k] == i; ++k){
+            A.append(i, t.col[k], t.value[k]);
+        }
+
+        A.finalize(i);
+    }
+
+    return A;
+}
+
+blaze_dsmat to_blaze_insert(const evb::triplets& t){
+    blaze_dsmat A(t.rows, t.cols);
+    A.reserve(t.nnz());
+
+    for(std::size_t k = 0; k < t.nnz(); ++k){
+        A.insert(t.row[k], t.col[k], t.value[k]);
+    }
+
+    return A;
+}
+
+eigen_dsmat to_eigen(const evb::triplets& t){
+    std::vector<Eigen::Triplet<double>> entries;
+    entries.reserve(t.nnz());
+
+    for(std::size_t k = 0; k < t.nnz(); ++k){
+        entries.emplace_back(t.row[k], t.col[k], t.value[k]);
+    }
+
+    eigen_dsmat A(t.rows, t.cols);
+    A.setFromTriplets(entries.begin(), entries.end());
+    return A;
+}
+
+eigen_dsmat to_eigen_insert(const evb::triplets& t){
+    Eigen::VectorXi per_row = Eigen::VectorXi::Zero(t.rows);
+
+    for(std::size_t k = 0; k < t.nnz(); ++k){
+        ++per_row[t.row[k]];
+    }
+
+    eigen_dsmat A(t.rows, t.cols);
+    A.reserve(per_row);
+
+    for(std::size_t k = 0; k < t.nnz(); ++k){
+        A.insert(t.row[k], t.col[k]) = t.value[k];
+    }
+
+    A.makeCompressed();
+    return A;
+}
+
+const evb::triplets& banded_matrix(std::size_t n){
+    return evb::memoize("banded-5-" + std::to_string(n), [n](){ return evb::banded(n, 5); });
+}
+
+const evb::triplets& narrow_banded_matrix(std::size_t n){
+    return evb::memoize("banded-2-" + std::to_string(n), [n](){ return evb::banded(n, 2); });
+}
+
+const evb::triplets& poisson_matrix(std::size_t k){
+    return evb::memoize("poisson-" + std::to_string(k), [k](){ return evb::poisson_2d(k); });
+}
+
+const evb::triplets& power_law_matrix(std::size_t scale){
+    return evb::memoize("power-law-" + std::to_string(scale), [scale](){ return evb::power_law(scale); });
+}
+
+std::vector<std::string> mtx_files(){
+    return evb::split(evb::env_string("EVB_MTX"));
+}
+
+// The i-th file of EVB_MTX
+const evb::triplets& mtx_matrix(std::size_t i){
+    auto path = mtx_files().at(i);
+
+    return evb::memoize("mtx-" + path, [path](){ return evb::load_matrix_market(path); });
+}
+
+// CSR traffic: values and 32-bit indices, row pointers, x and y
+double spmv_bytes(const evb::triplets& t){
+    return 12.0 * t.nnz() + 8.0 * (2 * t.rows + t.cols);
+}
+
+EVB_SECTION_P("y = A * x (banded)", VALUES_POLICY(1000, 10000, 100000, 1000000))
+    EVB_COST(double,
+        [](std::size_t n){ return 2.0 * banded_matrix(n).nnz(); },
+        [](std::size_t n){ return spmv_bytes(banded_matrix(n)); });
+
+    EVB_TWO_PASS_NS("blaze",
+        [](std::size_t n){ return std::make_tuple(to_blaze(banded_matrix(n)), blaze_dvec(n), blaze_dvec(n)); },
+        [](blaze_dsmat& A, blaze_dvec& x, blaze_dvec& y){ y = A * x; }
+        );
+
+    EVB_TWO_PASS_NS("eigen",
+        [](std::size_t n){ return std::make_tuple(to_eigen(banded_matrix(n)), eigen_dvec(n), eigen_dvec(n)); },
+        [](eigen_dsmat& A, eigen_dvec& x, eigen_dvec& y){ y = A * x; }
+        );
+}
+
+EVB_SECTION_P("y = A * x (banded, small)", VALUES_POLICY(100, 500, 1000, 5000))
+    EVB_COST(double,
+        [](std::size_t n){ return 2.0 * banded_matrix(n).nnz(); },
+        [](std::size_t n){ return spmv_bytes(banded_matrix(n)); });
+
+    EVB_TWO_PASS_NS("etl",
+        [](std::size_t n){ return std::make_tuple(to_etl(banded_matrix(n)), etl_dvec(n), etl_dvec(n)); },
+        [](etl_dsmat& A, etl_dvec& x, etl_dvec& y){ y = A * x; }
+        );
+
+    EVB_TWO_PASS_NS("blaze",
+        [](std::size_t n){ return std::make_tuple(to_blaze(banded_matrix(n)), blaze_dvec(n), blaze_dvec(n)); },
+        [](blaze_dsmat& A, blaze_dvec& x, blaze_dvec& y){ y = A * x; }
+        );
+
+    EVB_TWO_PASS_NS("eigen",
+        [](std::size_t n){ return std::make_tuple(to_eigen(banded_matrix(n)), eigen_dvec(n), eigen_dvec(n)); },
+        [](eigen_dsmat& A, eigen_dvec& x, eigen_dvec& y){ y = A * x; }
+        );
+}
+
+EVB_SECTION_P("y = A * x (poisson)", VALUES_POLICY(32, 100, 316, 1000))
+    EVB_COST(double,
+        [](std::size_t k){ return 2.0 * poisson_matrix(k).nnz(); },
+        [](std::size_t k){ return spmv_bytes(poisson_matrix(k)); });
+
+    EVB_TWO_PASS_NS("blaze",
+        [](std::size_t k){ return std::make_tuple(to_blaze(poisson_matrix(k)), blaze_dvec(k * k), blaze_dvec(k * k)); },
+        [](blaze_dsmat& A, blaze_dvec& x, blaze_dvec& y){ y = A * x; }
+        );
+
+    EVB_TWO_PASS_NS("eigen",
+        [](std::size_t k){ return std::make_tuple(to_eigen(poisson_matrix(k)), eigen_dvec(k * k), eigen_dvec(k * k)); },
+        [](eigen_dsmat& A, eigen_dvec& x, eigen_dvec& y){ y = A * x; }
+        );
+}
+
+EVB_SECTION_P("y = A * x (power-law)", VALUES_POLICY(12, 14, 16, 18, 20))
+    EVB_COST(double,
+        [](std::size_t s){ return 2.0 * power_law_matrix(s).nnz(); },
+        [](std::size_t s){ return spmv_bytes(power_law_matrix(s)); });
+
+    EVB_TWO_PASS_NS("blaze",
+        [](std::size_t s){ return std::make_tuple(to_blaze(power_law_matrix(s)), blaze_dvec(1UL << s), blaze_dvec(1UL << s)); },
+        [](blaze_dsmat& A, blaze_dvec& x, blaze_dvec& y){ y = A * x; }
+        );
+
+    EVB_TWO_PASS_NS("eigen",
+        [](std::size_t s){ return std::make_tuple(to_eigen(power_law_matrix(s)), eigen_dvec(1UL << s), eigen_dvec(1UL << s)); },
+        [](eigen_dsmat& A, eigen_dvec& x, eigen_dvec& y){ y = A * x; }
+        );
+}
+
+// One section per file of EVB_MTX, the sections past the number of files are skipped
+#define MTX_SECTION(I)                                                                                                                   \
+    EVB_SECTION_P("y = A * x (mtx " #I ")", VALUES_POLICY(I))                                                                            \
+        if(mtx_files().size() <= I){                                                                                                     \
+            return;                                                                                                                      \
+        }                                                                                                                                \
+                                                                                                                                         \
+        EVB_COST(double,                                                                                                                 \
+            [](std::size_t i){ return 2.0 * mtx_matrix(i).nnz(); },                                                                      \
+            [](std::size_t i){ return spmv_bytes(mtx_matrix(i)); });                                                                     \
+                                                                                                                                         \
+        EVB_TWO_PASS_NS("blaze",                                                                                                         \
+            [](std::size_t i){ auto& t = mtx_matrix(i); return std::make_tuple(to_blaze(t), blaze_dvec(t.cols), blaze_dvec(t.rows)); },  \
+            [](blaze_dsmat& A, blaze_dvec& x, blaze_dvec& y){ y = A * x; }                                                               \
+            );                                                                                                                           \
+                                                                                                                                         \
+        EVB_TWO_PASS_NS("eigen",                                                                                                         \
+            [](std::size_t i){ auto& t = mtx_matrix(i); return std::make_tuple(to_eigen(t), eigen_dvec(t.cols), eigen_dvec(t.rows)); },  \
+            [](eigen_dsmat& A, eigen_dvec& x, eigen_dvec& y){ y = A * x; }                                                               \
+            );                                                                                                                           \
+    }
+
+MTX_SECTION(0)
+MTX_SECTION(1)
+MTX_SECTION(2)
+MTX_SECTION(3)
+MTX_SECTION(4)
+MTX_SECTION(5)
+MTX_SECTION(6)
+MTX_SECTION(7)
+
+// Block of 32 right-hand sides
+EVB_SECTION_P("C = A * B (sparse * dense)", VALUES_POLICY(32, 100, 316))
+    EVB_COST(double,
+        [](std::size_t k){ return 2.0 * 32 * poisson_matrix(k).nnz(); },
+        [](std::size_t k){ return 12.0 * poisson_matrix(k).nnz() + 2.0 * 8 * 32 * k * k; });
+
+    EVB_TWO_PASS_NS("blaze",
+        [](std::size_t k){ return std::make_tuple(to_blaze(poisson_matrix(k)), blaze_dmat(k * k, 32), blaze_dmat(k * k, 32)); },
+        [](blaze_dsmat& A, blaze_dmat& B, blaze_dmat& C){ C = A * B; }
+        );
+
+    EVB_TWO_PASS_NS("eigen",
+        [](std::size_t k){ return std::make_tuple(to_eigen(poisson_matrix(k)), eigen_dmat(k * k, 32), eigen_dmat(k * k, 32)); },
+        [](eigen_dsmat& A, eigen_dmat& B, eigen_dmat& C){ C = A * B; }
+        );
+}
+
+EVB_SECTION_P("C = A + B (sparse)", VALUES_POLICY(32, 100, 316, 1000))
+    EVB_COST(double,
+        [](std::size_t k){ return 1.0 * (poisson_matrix(k).nnz() + narrow_banded_matrix(k * k).nnz()); },
+        [](std::size_t k){ return 2.0 * 12 * (poisson_matrix(k).nnz() + narrow_banded_matrix(k * k).nnz()); });
+
+    EVB_TWO_PASS_NS("blaze",
+        [](std::size_t k){ return std::make_tuple(to_blaze(poisson_matrix(k)), to_blaze(narrow_banded_matrix(k * k)), blaze_dsmat(k * k, k * k)); },
+        [](blaze_dsmat& A, blaze_dsmat& B, blaze_dsmat& C){ C = A + B; }
+        );
+
+    EVB_TWO_PASS_NS("eigen",
+        [](std::size_t k){ return std::make_tuple(to_eigen(poisson_matrix(k)), to_eigen(narrow_banded_matrix(k * k)), eigen_dsmat(k * k, k * k)); },
+        [](eigen_dsmat& A, eigen_dsmat& B, eigen_dsmat& C){ C = A + B; }
+        );
+}
+
+EVB_SECTION_P("B = A' (sparse)", VALUES_POLICY(12, 14, 16, 18))
+    EVB_COST(double,
+        [](std::size_t){ return 0.0; },
+        [](std::size_t s){ return 2.0 * 12 * power_law_matrix(s).nnz(); });
+
+    EVB_TWO_PASS_NS("blaze",
+        [](std::size_t s){ return std::make_tuple(to_blaze(power_law_matrix(s)), blaze_dsmat(1UL << s, 1UL << s)); },
+        [](blaze_dsmat& A, blaze_dsmat& B){ B = blaze::trans(A); }
+        );
+
+    EVB_TWO_PASS_NS("eigen",
+        [](std::size_t s){ return std::make_tuple(to_eigen(power_law_matrix(s)), eigen_dsmat(1UL << s, 1UL << s)); },
+        [](eigen_dsmat& A, eigen_dsmat& B){ B = A.transpose(); }
+        );
+}
+
+// Assembly of the compressed format from sorted triplets
+EVB_SECTION_P("A = assemble(triplets) (power-law)", VALUES_POLICY(12, 14, 16))
+    EVB_COST(double,
+        [](std::size_t){ return 0.0; },
+        [](std::size_t s){ return 36.0 * power_law_matrix(s).nnz(); });
+
+    EVB_TWO_PASS_NS("blaze-append",
+        [](std::size_t s){ return std::make_tuple(&power_law_matrix(s), blaze_dsmat()); },
+        [](const evb::triplets*& t, blaze_dsmat& A){ A = to_blaze(*t); }
+        );
+
+    EVB_TWO_PASS_NS("blaze-insert",
+        [](std::size_t s){ return std::make_tuple(&power_law_matrix(s), blaze_dsmat()); },
+        [](const evb::triplets*& t, blaze_dsmat& A){ A = to_blaze_insert(*t); }
+        );
+
+    EVB_TWO_PASS_NS("eigen-triplets",
+        [](std::size_t s){ return std::make_tuple(&power_law_matrix(s), eigen_dsmat()); },
+        [](const evb::triplets*& t, eigen_dsmat& A){ A = to_eigen(*t); }
+        );
+
+    EVB_TWO_PASS_NS("eigen-insert",
+        [](std::size_t s){ return std::make_tuple(&power_law_matrix(s), eigen_dsmat()); },
+        [](const evb::triplets*& t, eigen_dsmat& A){ A = to_eigen_insert(*t); }
+        );
+}
+
+EVB_SECTION_P("A = assemble(triplets) (banded, small)", VALUES_POLICY(100, 500, 1000, 5000))
+    EVB_COST(double,
+        [](std::size_t){ return 0.0; },
+        [](std::size_t n){ return 36.0 * banded_matrix(n).nnz(); });
+
+    EVB_TWO_PASS_NS("etl-set",
+        [](std::size_t n){ return std::make_tuple(&banded_matrix(n), etl_dsmat()); },
+        [](const evb::triplets*& t, etl_dsmat& A){ A = to_etl(*t); }
+        );
+
+    EVB_TWO_PASS_NS("blaze-append",
+        [](std::size_t n){ return std::make_tuple(&banded_matrix(n), blaze_dsmat()); },
+        [](const evb::triplets*& t, blaze_dsmat& A){ A = to_blaze(*t); }
+        );
+
+    EVB_TWO_PASS_NS("blaze-insert",
+        [](std::size_t n){ return std::make_tuple(&banded_matrix(n), blaze_dsmat()); },
+        [](const evb::triplets*& t, blaze_dsmat& A){ A = to_blaze_insert(*t); }
+        );
+
+    EVB_TWO_PASS_NS("eigen-triplets",
+        [](std::size_t n){ return std::make_tuple(&banded_matrix(n), eigen_dsmat()); },
+        [](const evb::triplets*& t, eigen_dsmat& A){ A = to_eigen(*t); }
+        );
+
+    EVB_TWO_PASS_NS("eigen-insert",
+        [](std::size_t n){ return std::make_tuple(&banded_matrix(n), eigen_dsmat()); },
+        [](const evb::triplets*& t, eigen_dsmat& A){ A = to_eigen_insert(*t); }
+        );
+}
+
+} //end of anonymous namespace
@@ -0,0 +1,300 @@
+#define CPM_LIB
+#include "benchmark.hpp"
+
+// The expressions of simple.cpp through views: sub-vectors, sub-matrices,
+// rows, columns and strided vectors. Each view is taken at an aligned
+// (offset 0) and at an unaligned (offset 1) position of a larger operand, the
+// "-dense" variants compute the same expression on whole operands and the
+// report gives the passes lost by each view over its dense variant.
+
+namespace {
+
+// A vector of every s-th element of a raw buffer
+using eigen_dvec_strided = Eigen::Map<const eigen_dvec, Eigen::Unaligned, Eigen::InnerStride<>>;
+
+// Pairs of (size, offset)
+using vector_view_policy = NARY_POLICY(
+    VALUES_POLICY(1000, 1000, 10000, 10000, 100000, 100000, 1000000, 1000000),
+    VALUES_POLICY(0, 1, 0, 1, 0, 1, 0, 1));
+
+using matrix_view_policy = NARY_POLICY(
+    VALUES_POLICY(64, 64, 128, 128, 256, 256, 512, 512, 1024, 1024),
+    VALUES_POLICY(0, 1, 0, 1, 0, 1, 0, 1, 0, 1));
+
+using gemm_view_policy = NARY_POLICY(
+    VALUES_POLICY(64, 64, 128, 128, 256, 256, 512, 512),
+    VALUES_POLICY(0, 1, 0, 1, 0, 1, 0, 1));
+
+// Pairs of (size, stride)
+using stride_policy = NARY_POLICY(
+    VALUES_POLICY(100000, 100000, 100000, 100000, 100000, 1000000, 1000000, 1000000, 1000000, 1000000),
+    VALUES_POLICY(1, 2, 4, 8, 16, 1, 2, 4, 8, 16));
+
+void tag_offset(std::size_t o){
+    evb::tag("offset", o ? "unaligned" : "aligned");
+}
+
+EVB_SECTION_P("r = a + b (sub-vector)", vector_view_policy)
+    EVB_COST(double,
+        [](std::size_t n, std::size_t){ return 1.0 * n; },
+        [](std::size_t n, std::size_t){ return 3.0 * 8 * n; });
+
+    EVB_PASSES("-dense", [](std::size_t n, std::size_t){ return 8.0 * n; });
+
+    EVB_TWO_PASS_NS("etl",
+        [](std::size_t n, std::size_t o){ tag_offset(o); return std::make_tuple(etl_dvec(n + o), etl_dvec(n + o), etl_dvec(n + o), o); },
+        [](etl_dvec& r, etl_dvec& a, etl_dvec& b, std::size_t& o){ etl::slice(r, o, r.size()) = etl::slice(a, o, a.size()) + etl::slice(b, o, b.size()); }
+        );
+
+    EVB_TWO_PASS_NS("etl-dense",
+        [](std::size_t n, std::size_t o){ tag_offset(o); return std::make_tuple(etl_dvec(n), etl_dvec(n), etl_dvec(n)); },
+        [](etl_dvec& r, etl_dvec& a, etl_dvec& b){ r = a + b; }
+        );
+
+    EVB_TWO_PASS_NS("blaze",
+        [](std::size_t n, std::size_t o){ tag_offset(o); return std::make_tuple(blaze_dvec(n + o), blaze_dvec(n + o), blaze_dvec(n + o), o); },
+        [](blaze_dvec& r, blaze_dvec& a, blaze_dvec& b, std::size_t& o){ blaze::subvector(r, o, r.size() - o) = blaze::subvector(a, o, a.size() - o) + blaze::subvector(b, o, b.size() - o); }
+        );
+
+    EVB_TWO_PASS_NS("blaze-dense",
+        [](std::size_t n, std::size_t o){ tag_offset(o); return std::make_tuple(blaze_dvec(n), blaze_dvec(n), blaze_dvec(n)); },
+        [](blaze_dvec& r, blaze_dvec& a, blaze_dvec& b){ r = a + b; }
+        );
+
+    EVB_TWO_PASS_NS("eigen",
+        [](std::size_t n, std::size_t o){ tag_offset(o); return std::make_tuple(eigen_dvec(n + o), eigen_dvec(n + o), eigen_dvec(n + o), o); },
+        [](eigen_dvec& r, eigen_dvec& a, eigen_dvec& b, std::size_t& o){ r.tail(r.size() - o) = a.tail(a.size() - o) + b.tail(b.size() - o); }
+        );
+
+    EVB_TWO_PASS_NS("eigen-dense",
+        [](std::size_t n, std::size_t o){ tag_offset(o); return std::make_tuple(eigen_dvec(n), eigen_dvec(n), eigen_dvec(n)); },
+        [](eigen_dvec& r, eigen_dvec& a, eigen_dvec& b){ r = a + b; }
+        );
+}
+
+EVB_SECTION_P("R = A + B (sub-matrix)", matrix_view_policy)
+    EVB_COST(double,
+        [](std::size_t n, std::size_t){ return 1.0 * n * n; },
+        [](std::size_t n, std::size_t){ return 3.0 * 8 * n * n; });
+
+    EVB_PASSES("-dense", [](std::size_t n, std::size_t){ return 8.0 * n * n; });
+
+    EVB_TWO_PASS_NS("etl",
+        [](std::size_t n, std::size_t o){ tag_offset(o); return std::make_tuple(etl_dmat(n + o, n + o), etl_dmat(n + o, n + o), etl_dmat(n + o, n + o), o); },
+        [](etl_dmat& R, etl_dmat& A, etl_dmat& B, std::size_t& o){
+            auto n = etl::rows(R) - o;
+
+            etl::sub(R, o, o, n, n) = etl::sub(A, o, o, n, n) + etl::sub(B, o, o, n, n);
+        });
+
+    EVB_TWO_PASS_NS("etl-dense",
+        [](std::size_t n, std::size_t o){ tag_offset(o); return std::make_tuple(etl_dmat(n, n), etl_dmat(n, n), etl_dmat(n, n)); },
+        [](etl_dmat& R, etl_dmat& A, etl_dmat& B){ R = A + B; }
+        );
+
+    EVB_TWO_PASS_NS("blaze",
+        [](std::size_t n, std::size_t o){ tag_offset(o); return std::make_tuple(blaze_dmat(n + o, n + o), blaze_dmat(n + o, n + o), blaze_dmat(n + o, n + o), o); },
+        [](blaze_dmat& R, blaze_dmat& A, blaze_dmat& B, std::size_t& o){
+            auto n = R.rows() - o;
+
+            blaze::submatrix(R, o, o, n, n) = blaze::submatrix(A, o, o, n, n) + blaze::submatrix(B, o, o, n, n);
+        });
+
+    EVB_TWO_PASS_NS("blaze-dense",
+        [](std::size_t n, std::size_t o){ tag_offset(o); return std::make_tuple(blaze_dmat(n, n), blaze_dmat(n, n), blaze_dmat(n, n)); },
+        [](blaze_dmat& R, blaze_dmat& A, blaze_dmat& B){ R = A + B; }
+        );
+
+    EVB_TWO_PASS_NS("eigen",
+        [](std::size_t n, std::size_t o){ tag_offset(o); return std::make_tuple(eigen_dmat(n + o, n + o), eigen_dmat(n + o, n + o), eigen_dmat(n + o, n + o), o); },
+        [](eigen_dmat& R, eigen_dmat& A, eigen_dmat& B, std::size_t& o){
+            auto n = R.rows() - o;
+
+            R.block(o, o, n, n) = A.block(o, o, n, n) + B.block(o, o, n, n);
+        });
+
+    EVB_TWO_PASS_NS("eigen-dense",
+        [](std::size_t n, std::size_t o){ tag_offset(o); return std::make_tuple(eigen_dmat(n, n), eigen_dmat(n, n), eigen_dmat(n, n)); },
+        [](eigen_dmat& R, eigen_dmat& A, eigen_dmat& B){ R = A + B; }
+        );
+}
+
+// A panel update, the product of two blocks into a block
+EVB_SECTION_P("R = A * B (sub-matrix)", gemm_view_policy)
+    EVB_COST(double,
+        [](std::size_t n, std::size_t){ return 2.0 * n * n * n; },
+        [](std::size_t n, std::size_t){ return 3.0 * 8 * n * n; });
+
+    EVB_PASSES("-dense", [](std::size_t n, std::size_t){ return 8.0 * n * n; });
+
+    EVB_TWO_PASS_NS("etl",
+        [](std::size_t n, std::size_t o){ tag_offset(o); return std::make_tuple(etl_dmat(n + o, n + o), etl_dmat(n + o, n + o), etl_dmat(n + o, n + o), o); },
+        [](etl_dmat& R, etl_dmat& A, etl_dmat& B, std::size_t& o){
+            auto n = etl::rows(R) - o;
+
+            etl::sub(R, o, o, n, n) = etl::sub(A, o, o, n, n) * etl::sub(B, o, o, n, n);
+        });
+
+    EVB_TWO_PASS_NS("etl-dense",
+        [](std::size_t n, std::size_t o){ tag_offset(o); return std::make_tuple(etl_dmat(n, n), etl_dmat(n, n), etl_dmat(n, n)); },
+        [](etl_dmat& R, etl_dmat& A, etl_dmat& B){ R = A * B; }
+        );
+
+    EVB_TWO_PASS_NS("blaze",
+        [](std::size_t n, std::size_t o){ tag_offset(o); return std::make_tuple(blaze_dmat(n + o, n + o), blaze_dmat(n + o, n + o), blaze_dmat(n + o, n + o), o); },
+        [](blaze_dmat& R, blaze_dmat& A, blaze_dmat& B, std::size_t& o){
+            auto n = R.rows() - o;
+
+            blaze::submatrix(R, o, o, n, n) = blaze::submatrix(A, o, o, n, n) * blaze::submatrix(B, o, o, n, n);
+        });
+
+    EVB_TWO_PASS_NS("blaze-dense",
+        [](std::size_t n, std::size_t o){ tag_offset(o); return std::make_tuple(blaze_dmat(n, n), blaze_dmat(n, n), blaze_dmat(n, n)); },
+        [](blaze_dmat& R, blaze_dmat& A, blaze_dmat& B){ R = A * B; }
+        );
+
+    EVB_TWO_PASS_NS("eigen",
+        [](std::size_t n, std::size_t o){ tag_offset(o); return std::make_tuple(eigen_dmat(n + o, n + o), eigen_dmat(n + o, n + o), eigen_dmat(n + o, n + o), o); },
+        [](eigen_dmat& R, eigen_dmat& A, eigen_dmat& B, std::size_t& o){
+            auto n = R.rows() - o;
+
+            R.block(o, o, n, n).noalias() = A.block(o, o, n, n) * B.block(o, o, n, n);
+        });
+
+    EVB_TWO_PASS_NS("eigen-dense",
+        [](std::size_t n, std::size_t o){ tag_offset(o); return std::make_tuple(eigen_dmat(n, n), eigen_dmat(n, n), eigen_dmat(n, n)); },
+        [](eigen_dmat& R, eigen_dmat& A, eigen_dmat& B){ R.noalias() = A * B; }
+        );
+}
+
+// Each row scaled by its own factor, on matrices of n + offset columns, an
+// unaligned offset leaves every other row unaligned. The rows are contiguous
+// in ETL and Blaze and strided in Eigen.
+EVB_SECTION_P("R(i) = A(i) * s[i] (rows)", matrix_view_policy)
+    EVB_COST(double,
+        [](std::size_t n, std::size_t o){ return 1.0 * n * (n + o); },
+        [](std::size_t n, std::size_t o){ return 8.0 * (2 * n * (n + o) + n); });
+
+    EVB_PASSES("-dense", [](std::size_t n, std::size_t o){ return 8.0 * n * (n + o); });
+
+    EVB_TWO_PASS_NS("etl",
+        [](std::size_t n, std::size_t o){ tag_offset(o); return std::make_tuple(etl_dmat(n, n + o), etl_dmat(n, n + o), etl_dvec(n)); },
+        [](etl_dmat& R, etl_dmat& A, etl_dvec& s){
+            for(std::size_t i = 0; i < etl::rows(R); ++i){
+                etl::row(R, i) = etl::row(A, i) * s[i];
+            }
+        });
+
+    EVB_TWO_PASS_NS("etl-dense",
+        [](std::size_t n, std::size_t o){ tag_offset(o); return std::make_tuple(etl_dmat(n, n + o), etl_dmat(n, n + o), etl_dvec(n)); },
+        [](etl_dmat& R, etl_dmat& A, etl_dvec& s){ R = A * s[0]; }
+        );
+
+    EVB_TWO_PASS_NS("blaze",
+        [](std::size_t n, std::size_t o){ tag_offset(o); return std::make_tuple(blaze_dmat(n, n + o), blaze_dmat(n, n + o), blaze_dvec(n)); },
+        [](blaze_dmat& R, blaze_dmat& A, blaze_dvec& s){
+            for(std::size_t i = 0; i < R.rows(); ++i){
+                blaze::row(R, i) = blaze::row(A, i) * s[i];
+            }
+        });
+
+    EVB_TWO_PASS_NS("blaze-dense",
+        [](std::size_t n, std::size_t o){ tag_offset(o); return std::make_tuple(blaze_dmat(n, n + o), blaze_dmat(n, n + o), blaze_dvec(n)); },
+        [](blaze_dmat& R, blaze_dmat& A, blaze_dvec& s){ R = A * s[0]; }
+        );
+
+    EVB_TWO_PASS_NS("eigen",
+        [](std::size_t n, std::size_t o){ tag_offset(o); return std::make_tuple(eigen_dmat(n, n + o), eigen_dmat(n, n + o), eigen_dvec(n)); },
+        [](eigen_dmat& R, eigen_dmat& A, eigen_dvec& s){
+            for(Eigen::Index i = 0; i < R.rows(); ++i){
+                R.row(i) = A.row(i) * s[i];
+            }
+        });
+
+    EVB_TWO_PASS_NS("eigen-dense",
+        [](std::size_t n, std::size_t o){ tag_offset(o); return std::make_tuple(eigen_dmat(n, n + o), eigen_dmat(n, n + o), eigen_dvec(n)); },
+        [](eigen_dmat& R, eigen_dmat& A, eigen_dvec& s){ R = A * s[0]; }
+        );
+}
+
+// Each column scaled by its own factor, on matrices of n + offset rows. The
+// columns are strided in ETL and Blaze and contiguous in Eigen.
+EVB_SECTION_P("R(:, j) = A(:, j) * s[j] (columns)", matrix_view_policy)
+    EVB_COST(double,
+        [](std::size_t n, std::size_t o){ return 1.0 * n * (n + o); },
+        [](std::size_t n, std::size_t o){ return 8.0 * (2 * n * (n + o) + n); });
+
+    EVB_PASSES("-dense", [](std::size_t n, std::size_t o){ return 8.0 * n * (n + o); });
+
+    EVB_TWO_PASS_NS("etl",
+        [](std::size_t n, std::size_t o){ tag_offset(o); return std::make_tuple(etl_dmat(n + o, n), etl_dmat(n + o, n), etl_dvec(n)); },
+        [](etl_dmat& R, etl_dmat& A, etl_dvec& s){
+            for(std::size_t j = 0; j < etl::columns(R); ++j){
+                etl::col(R, j) = etl::col(A, j) * s[j];
+            }
+        });
+
+    EVB_TWO_PASS_NS("etl-dense",
+        [](std::size_t n, std::size_t o){ tag_offset(o); return std::make_tuple(etl_dmat(n + o, n), etl_dmat(n + o, n), etl_dvec(n)); },
+        [](etl_dmat& R, etl_dmat& A, etl_dvec& s){ R = A * s[0]; }
+        );
+
+    EVB_TWO_PASS_NS("blaze",
+        [](std::size_t n, std::size_t o){ tag_offset(o); return std::make_tuple(blaze_dmat(n + o, n), blaze_dmat(n + o, n), blaze_dvec(n)); },
+        [](blaze_dmat& R, blaze_dmat& A, blaze_dvec& s){
+            for(std::size_t j = 0; j < R.columns(); ++j){
+                blaze::column(R, j) = blaze::column(A, j) * s[j];
+            }
+        });
+
+    EVB_TWO_PASS_NS("blaze-dense",
+        [](std::size_t n, std::size_t o){ tag_offset(o); return std::make_tuple(blaze_dmat(n + o, n), blaze_dmat(n + o, n), blaze_dvec(n)); },
+        [](blaze_dmat& R, blaze_dmat& A, blaze_dvec& s){ R = A * s[0]; }
+        );
+
+    EVB_TWO_PASS_NS("eigen",
+        [](std::size_t n, std::size_t o){ tag_offset(o); return std::make_tuple(eigen_dmat(n + o, n), eigen_dmat(n + o, n), eigen_dvec(n)); },
+        [](eigen_dmat& R, eigen_dmat& A, eigen_dvec& s){
+            for(Eigen::Index j = 0; j < R.cols(); ++j){
+                R.col(j) = A.col(j) * s[j];
+            }
+        });
+
+    EVB_TWO_PASS_NS("eigen-dense",
+        [](std::size_t n, std::size_t o){ tag_offset(o); return std::make_tuple(eigen_dmat(n + o, n), eigen_dmat(n + o, n), eigen_dvec(n)); },
+        [](eigen_dmat& R, eigen_dmat& A, eigen_dvec& s){ R = A * s[0]; }
+        );
+}
+
+// Every s-th element of a and b. ETL has no strided view of a vector, the
+// vectors are seen as matrices of s columns and their first column is used.
+// The cost model only counts the used elements, not the loaded cache lines.
+EVB_SECTION_P("r = a[::s] + b[::s] (strided)", stride_policy)
+    EVB_COST(double,
+        [](std::size_t n, std::size_t){ return 1.0 * n; },
+        [](std::size_t n, std::size_t){ return 3.0 * 8 * n; });
+
+    EVB_TWO_PASS_NS("etl",
+        [](std::size_t n, std::size_t s){ return std::make_tuple(etl_dvec(n), etl_dvec(n * s), etl_dvec(n * s), s); },
+        [](etl_dvec& r, etl_dvec& a, etl_dvec& b, std::size_t& s){
+            auto n = etl::size(r);
+
+            r = etl::col(etl::reshape(a, n, s), 0) + etl::col(etl::reshape(b, n, s), 0);
+        });
+
+    EVB_TWO_PASS_NS("blaze",
+        [](std::size_t n, std::size_t s){ return std::make_tuple(blaze_dvec(n), blaze_dvec(n * s), blaze_dvec(n * s), s); },
+        [](blaze_dvec& r, blaze_dvec& a, blaze_dvec& b, std::size_t& s){
+            auto stride = [s](std::size_t i){ return i * s; };
+
+            r = blaze::elements(a, stride, r.size()) + blaze::elements(b, stride, r.size());
+        });
+
+    EVB_TWO_PASS_NS("eigen",
+        [](std::size_t n, std::size_t s){ return std::make_tuple(eigen_dvec(n), eigen_dvec(n * s), eigen_dvec(n * s), s); },
+        [](eigen_dvec& r, eigen_dvec& a, eigen_dvec& b, std::size_t& s){
+            r = eigen_dvec_strided(a.data(), r.size(), Eigen::InnerStride<>(s)) + eigen_dvec_strided(b.data(), r.size(), Eigen::InnerStride<>(s));
+        });
+}
+
+} //end of anonymous namespace